@@ -0,0 +1,461 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// Scanner throughput benchmark.
+//
+// Usage: mem_bench [--json <file>] [--csv <file>] [--filter <text>] [--min-time <seconds>]
+//
+// Every scanner is run over every (pattern, input) pair. Each run is repeated until min-time has elapsed and the
+// fastest repetition is reported. Results are written as JSON (default mem_bench.json) and optionally as CSV.
+
+#include <mem/memory/module.h>
+#include <mem/scanning/auto_scanner.h>
+#include <mem/scanning/boyer_moore_scanner.h>
+#include <mem/scanning/pattern.h>
+#include <mem/scanning/simd_scanner.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct bench_input
+    {
+        std::string name;
+        std::vector<mem::region> regions;
+        std::vector<mem::byte> storage;
+
+        std::size_t size() const
+        {
+            std::size_t total = 0;
+
+            for (const mem::region& range : regions)
+                total += range.size;
+
+            return total;
+        }
+    };
+
+    struct bench_pattern
+    {
+        const char* name;
+        const char* text;
+
+        // Pathological input generated from the pattern, or nullptr
+        void (*pathology)(const mem::pattern& pattern, bench_input& input);
+    };
+
+    struct bench_result
+    {
+        std::string scanner;
+        std::string pattern;
+        std::string input;
+        std::string engine;
+
+        std::size_t bytes {0};
+        std::size_t hits {0};
+        std::size_t candidates {0};
+        std::size_t iterations {0};
+
+        double seconds {0.0};
+
+        double gbps() const
+        {
+            return seconds > 0.0 ? static_cast<double>(bytes) / seconds / 1e9 : 0.0;
+        }
+
+        double candidates_per_mb() const
+        {
+            return bytes ? static_cast<double>(candidates) * 0x100000 / static_cast<double>(bytes) : 0.0;
+        }
+
+        double ns_per_hit() const
+        {
+            return hits ? seconds * 1e9 / static_cast<double>(hits) : 0.0;
+        }
+    };
+
+    const std::size_t synthetic_size = 0x2000000;
+
+    void make_owned(bench_input& input)
+    {
+        input.regions.assign(1, mem::region(input.storage.data(), input.storage.size()));
+    }
+
+    bench_input random_input()
+    {
+        // Bytes drawn with the same skew as simd_scanner::default_frequencies, so common anchors really are common
+        const mem::byte* const frequencies = mem::simd_scanner::default_frequencies();
+
+        std::vector<double> weights(256);
+
+        for (std::size_t i = 0; i < 256; ++i)
+            weights[i] = std::pow(static_cast<double>(frequencies[i]) + 1.0, 3.0);
+
+        std::mt19937 rng(0x6D656D);
+        std::discrete_distribution<int> dist(weights.begin(), weights.end());
+
+        bench_input input;
+        input.name = "random";
+        input.storage.resize(synthetic_size);
+
+        for (mem::byte& value : input.storage)
+            value = static_cast<mem::byte>(dist(rng));
+
+        make_owned(input);
+
+        return input;
+    }
+
+    bench_input uniform_input()
+    {
+        std::mt19937 rng(0x756E69);
+
+        bench_input input;
+        input.name = "uniform";
+        input.storage.resize(synthetic_size);
+
+        for (mem::byte& value : input.storage)
+            value = static_cast<mem::byte>(rng());
+
+        make_owned(input);
+
+        return input;
+    }
+
+    bench_input zero_input()
+    {
+        bench_input input;
+        input.name = "zeros";
+        input.storage.assign(synthetic_size, 0x00);
+
+        make_owned(input);
+
+        return input;
+    }
+
+    bench_input module_input(const char* name, mem::module module)
+    {
+        bench_input input;
+        input.name = name;
+
+        if (module.size)
+        {
+            // Only the readable segments are mapped, the gaps between them are not
+            module.enum_segments([&input](mem::region range, mem::prot_flags prot) {
+                if (prot & mem::prot_flags::R)
+                    input.regions.push_back(range);
+
+                return false;
+            });
+        }
+
+        return input;
+    }
+
+    // The pattern repeated back to back with its last solid byte flipped, so every anchor is a near-match
+    void near_miss_input(const mem::pattern& pattern, bench_input& input)
+    {
+        const std::size_t size = pattern.trimmed_size();
+
+        std::vector<mem::byte> unit(pattern.bytes(), pattern.bytes() + size);
+
+        for (std::size_t i = size; i--;)
+        {
+            if (pattern.masks()[i] == 0xFF)
+            {
+                unit[i] = static_cast<mem::byte>(~unit[i]);
+                break;
+            }
+        }
+
+        input.name = "near_miss";
+        input.storage.resize(synthetic_size - synthetic_size % size);
+
+        for (std::size_t i = 0; i < input.storage.size(); i += size)
+            std::memcpy(&input.storage[i], unit.data(), size);
+
+        make_owned(input);
+    }
+
+    std::size_t count_candidates(const mem::simd_scanner& scanner, const mem::pattern& pattern, const bench_input& input)
+    {
+        const std::size_t skip_pos = scanner.skip_pos();
+
+        if (skip_pos == SIZE_MAX)
+            return 0;
+
+        const mem::byte anchor = pattern.bytes()[skip_pos];
+
+        std::size_t total = 0;
+
+        for (const mem::region& range : input.regions)
+        {
+            const mem::byte* const start = range.start.as<const mem::byte*>();
+
+            total += static_cast<std::size_t>(std::count(start, start + range.size, anchor));
+        }
+
+        return total;
+    }
+
+    template <typename Scanner>
+    bench_result run(const char* scanner_name, const Scanner& scanner, const bench_pattern& pattern,
+        const bench_input& input, double min_time)
+    {
+        bench_result result;
+        result.scanner = scanner_name;
+        result.pattern = pattern.name;
+        result.input = input.name;
+        result.bytes = input.size();
+
+        double elapsed = 0.0;
+        double best = 0.0;
+
+        do
+        {
+            std::size_t hits = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+
+            for (const mem::region& range : input.regions)
+            {
+                scanner.scan_all(range, [&hits](mem::pointer) {
+                    ++hits;
+                    return false;
+                });
+            }
+
+            const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+            if (!result.iterations || duration.count() < best)
+                best = duration.count();
+
+            result.hits = hits;
+            elapsed += duration.count();
+            ++result.iterations;
+        } while (elapsed < min_time);
+
+        result.seconds = best;
+
+        return result;
+    }
+
+    std::string escape_json(const std::string& text)
+    {
+        std::string result;
+
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+
+            result += c;
+        }
+
+        return result;
+    }
+
+    const char* simd_level()
+    {
+#if defined(MEM_SIMD_AVX2)
+        return "avx2";
+#elif defined(MEM_SIMD_SSE2)
+        return "sse2";
+#else
+        return "none";
+#endif
+    }
+
+    bool write_json(const char* path, const std::vector<bench_result>& results)
+    {
+        std::FILE* file = std::fopen(path, "w");
+
+        if (!file)
+            return false;
+
+        std::fprintf(file, "{\n  \"timestamp\": %lld,\n  \"simd\": \"%s\",\n  \"results\": [\n",
+            static_cast<long long>(std::time(nullptr)), simd_level());
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const bench_result& r = results[i];
+
+            std::fprintf(file,
+                "    {\"scanner\": \"%s\", \"pattern\": \"%s\", \"input\": \"%s\", \"engine\": \"%s\", "
+                "\"bytes\": %zu, \"hits\": %zu, \"iterations\": %zu, \"seconds\": %.9f, \"gbps\": %.4f, "
+                "\"candidates_per_mb\": %.2f, \"ns_per_hit\": %.2f}%s\n",
+                escape_json(r.scanner).c_str(), escape_json(r.pattern).c_str(), escape_json(r.input).c_str(),
+                escape_json(r.engine).c_str(), r.bytes, r.hits, r.iterations, r.seconds, r.gbps(),
+                r.candidates_per_mb(), r.ns_per_hit(), (i + 1 < results.size()) ? "," : "");
+        }
+
+        std::fprintf(file, "  ]\n}\n");
+
+        return std::fclose(file) == 0;
+    }
+
+    bool write_csv(const char* path, const std::vector<bench_result>& results)
+    {
+        std::FILE* file = std::fopen(path, "w");
+
+        if (!file)
+            return false;
+
+        std::fprintf(file, "scanner,pattern,input,engine,bytes,hits,iterations,seconds,gbps,candidates_per_mb,ns_per_hit\n");
+
+        for (const bench_result& r : results)
+        {
+            std::fprintf(file, "%s,%s,%s,%s,%zu,%zu,%zu,%.9f,%.4f,%.2f,%.2f\n", r.scanner.c_str(), r.pattern.c_str(),
+                r.input.c_str(), r.engine.c_str(), r.bytes, r.hits, r.iterations, r.seconds, r.gbps(),
+                r.candidates_per_mb(), r.ns_per_hit());
+        }
+
+        return std::fclose(file) == 0;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* json_path = "mem_bench.json";
+    const char* csv_path = nullptr;
+    const char* filter = nullptr;
+    double min_time = 0.25;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (!std::strcmp(argv[i], "--json") && has_value)
+            json_path = argv[++i];
+        else if (!std::strcmp(argv[i], "--csv") && has_value)
+            csv_path = argv[++i];
+        else if (!std::strcmp(argv[i], "--filter") && has_value)
+            filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--min-time") && has_value)
+            min_time = std::atof(argv[++i]);
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--json <file>] [--csv <file>] [--filter <text>] [--min-time <seconds>]\n",
+                argv[0]);
+            return 1;
+        }
+    }
+
+    const bench_pattern patterns[] {
+        {"rare_anchor", "9A 5E 3F 38 31 22", nullptr},
+        {"call_rel32", "E8 ? ? ? ? 48 8B", near_miss_input},
+        {"prologue", "48 89 5C 24 ? 57 48 83 EC ?", near_miss_input},
+        {"nibble_masks", "48 8? 0D ? ? ? ? E8 ?? ?? ?? ?? 8?", near_miss_input},
+        {"common_anchor", "00 00 00 00 ? 00 00 01", near_miss_input},
+        {"wildcard_run", "E8 ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? ? C3", near_miss_input},
+        {"long_solid", "48 8B 05 11 22 33 44 48 85 C0 74 10 48 8B 40 08 48 85 C0 74 07 FF D0 48 83 C4 28 C3",
+            near_miss_input},
+    };
+
+    std::vector<bench_input> inputs;
+    inputs.push_back(random_input());
+    inputs.push_back(uniform_input());
+    inputs.push_back(zero_input());
+    inputs.push_back(module_input("libc", mem::module::named("libc.so.6")));
+    inputs.push_back(module_input("self", mem::module::self()));
+
+    std::vector<bench_result> results;
+
+    std::printf("%-12s %-14s %-10s %-12s %10s %10s %12s %10s\n", "scanner", "pattern", "input", "engine", "GB/s",
+        "hits", "cand/MB", "ns/hit");
+
+    const auto report = [&results](bench_result result) {
+        std::printf("%-12s %-14s %-10s %-12s %10.3f %10zu %12.1f %10.1f\n", result.scanner.c_str(),
+            result.pattern.c_str(), result.input.c_str(), result.engine.c_str(), result.gbps(), result.hits,
+            result.candidates_per_mb(), result.ns_per_hit());
+
+        results.push_back(std::move(result));
+    };
+
+    for (const bench_pattern& entry : patterns)
+    {
+        if (filter && !std::strstr(entry.name, filter))
+            continue;
+
+        const mem::pattern pattern(entry.text);
+
+        const mem::simd_scanner simd(pattern);
+        const mem::boyer_moore_scanner bm(pattern);
+        const mem::auto_scanner automatic(pattern);
+
+        std::vector<const bench_input*> pattern_inputs;
+
+        for (const bench_input& input : inputs)
+            pattern_inputs.push_back(&input);
+
+        bench_input pathological;
+
+        if (entry.pathology)
+        {
+            entry.pathology(pattern, pathological);
+            pattern_inputs.push_back(&pathological);
+        }
+
+        for (const bench_input* input : pattern_inputs)
+        {
+            if (input->regions.empty())
+                continue;
+
+            const std::size_t candidates = count_candidates(simd, pattern, *input);
+
+            bench_result result = run("simd", simd, entry, *input, min_time);
+            result.engine = "simd";
+            result.candidates = candidates;
+            report(std::move(result));
+
+            result = run("boyer_moore", bm, entry, *input, min_time);
+            result.engine = "boyer_moore";
+            result.candidates = candidates;
+            report(std::move(result));
+
+            result = run("auto", automatic, entry, *input, min_time);
+            result.engine = mem::engine_name(automatic.engine());
+            result.candidates = candidates;
+            report(std::move(result));
+        }
+    }
+
+    if (json_path && !write_json(json_path, results))
+    {
+        std::fprintf(stderr, "Failed to write %s\n", json_path);
+        return 1;
+    }
+
+    if (csv_path && !write_csv(csv_path, results))
+    {
+        std::fprintf(stderr, "Failed to write %s\n", csv_path);
+        return 1;
+    }
+
+    return 0;
+}
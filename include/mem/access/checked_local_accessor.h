@@ -0,0 +1,192 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_CHECKED_LOCAL_ACCESSOR_BRICK_H
+#define MEM_CHECKED_LOCAL_ACCESSOR_BRICK_H
+
+#include <mem/access/local_memory_accessor.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__unix__)
+#    include <errno.h>
+#    include <fcntl.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
+namespace mem
+{
+    // Reads memory of the current process through the kernel, so an address which cannot be read makes the read
+    // fail, or come up short, instead of faulting. Nothing else differs from local_memory_accessor.
+    //
+    // On Linux this is process_vm_readv on the process itself, or pread on /proc/self/mem where that is not
+    // allowed. The latter reads pages without read access too, and only fails on unmapped addresses.
+    // On Windows it is ReadProcessMemory on the current process.
+    class checked_local_accessor : public local_memory_accessor
+    {
+    private:
+#if defined(__unix__)
+        std::size_t page_size_ {0};
+        int mem_fd_ {-1}; // Only opened when process_vm_readv cannot be used
+
+        std::size_t read_vm(std::uintptr_t src, byte* dst, std::size_t size) const;
+        std::size_t read_mem(std::uintptr_t src, byte* dst, std::size_t size) const;
+#endif
+
+    public:
+        // Throws std::runtime_error when neither way of reading is available
+        checked_local_accessor();
+        ~checked_local_accessor();
+
+        checked_local_accessor(const checked_local_accessor&) = delete;
+        checked_local_accessor& operator=(const checked_local_accessor&) = delete;
+
+        bool read(void* src, void* dst, std::size_t size) const override;
+
+#if defined(__unix__)
+        // Stops exactly at the first byte which cannot be read
+        std::size_t read_partial(void* src, void* dst, std::size_t size) const override;
+#endif
+    };
+
+#if defined(__unix__)
+    inline checked_local_accessor::checked_local_accessor()
+        : page_size_(static_cast<std::size_t>(sysconf(_SC_PAGESIZE)))
+    {
+        byte source = 1;
+        byte target = 0;
+
+        // Blocked by some seccomp filters, or missing from old kernels
+        if (read_vm(reinterpret_cast<std::uintptr_t>(&source), &target, 1) == 1)
+            return;
+
+        mem_fd_ = open("/proc/self/mem", O_RDONLY | O_CLOEXEC);
+
+        if (mem_fd_ == -1)
+            throw std::runtime_error("Failed to open /proc/self/mem");
+    }
+
+    inline checked_local_accessor::~checked_local_accessor()
+    {
+        if (mem_fd_ != -1)
+            close(mem_fd_);
+    }
+
+    inline std::size_t checked_local_accessor::read_vm(std::uintptr_t src, byte* dst, std::size_t size) const
+    {
+        // Partial reads only stop between iovecs, so each one ends on a page boundary
+        static constexpr const std::size_t max_pieces {256};
+
+        const pid_t pid = getpid();
+
+        std::size_t total = 0;
+
+        while (total < size)
+        {
+            iovec remote[max_pieces];
+            std::size_t count = 0;
+            std::size_t length = 0;
+
+            for (; (count < max_pieces) && (total + length < size); ++count)
+            {
+                const std::uintptr_t address = src + total + length;
+                const std::size_t piece = (std::min)(size - total - length, page_size_ - (address & (page_size_ - 1)));
+
+                remote[count].iov_base = reinterpret_cast<void*>(address);
+                remote[count].iov_len = piece;
+
+                length += piece;
+            }
+
+            iovec local;
+            local.iov_base = dst + total;
+            local.iov_len = length;
+
+            const ssize_t result = process_vm_readv(pid, &local, 1, remote, count, 0);
+
+            if (result <= 0)
+                break;
+
+            total += static_cast<std::size_t>(result);
+
+            if (static_cast<std::size_t>(result) != length)
+                break;
+        }
+
+        return total;
+    }
+
+    inline std::size_t checked_local_accessor::read_mem(std::uintptr_t src, byte* dst, std::size_t size) const
+    {
+        std::size_t total = 0;
+
+        while (total < size)
+        {
+            const ssize_t result = pread(mem_fd_, dst + total, size - total, static_cast<off_t>(src + total));
+
+            if (result <= 0)
+            {
+                if ((result == -1) && (errno == EINTR))
+                    continue;
+
+                break;
+            }
+
+            total += static_cast<std::size_t>(result);
+        }
+
+        return total;
+    }
+
+    inline std::size_t checked_local_accessor::read_partial(void* src, void* dst, std::size_t size) const
+    {
+        if (!src || !dst || size == 0)
+            return 0;
+
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(src);
+
+        return (mem_fd_ != -1) ? read_mem(address, static_cast<byte*>(dst), size)
+                               : read_vm(address, static_cast<byte*>(dst), size);
+    }
+
+    MEM_STRONG_INLINE bool checked_local_accessor::read(void* src, void* dst, std::size_t size) const
+    {
+        return (size != 0) && (read_partial(src, dst, size) == size);
+    }
+#elif defined(_WIN32)
+    inline checked_local_accessor::checked_local_accessor() = default;
+
+    inline checked_local_accessor::~checked_local_accessor() = default;
+
+    MEM_STRONG_INLINE bool checked_local_accessor::read(void* src, void* dst, std::size_t size) const
+    {
+        if (!src || !dst || size == 0)
+            return false;
+
+        SIZE_T bytes_read = 0;
+
+        return ::ReadProcessMemory(::GetCurrentProcess(), src, dst, size, &bytes_read) && (bytes_read == size);
+    }
+#endif
+} // namespace mem
+
+#endif // MEM_CHECKED_LOCAL_ACCESSOR_BRICK_H
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 namespace mem
 {
@@ -38,13 +39,30 @@ namespace mem
     {
     public:
         virtual bool read(void* src, void* dst, std::size_t size) const = 0;
+
+        // Reads as much of [src, src + size) as it can, returning how many bytes from src were read
+        virtual std::size_t read_partial(void* src, void* dst, std::size_t size) const;
+
         virtual bool write(void* src, void* dst, std::size_t size) const = 0;
         virtual bool fill(void* dst, byte value, std::size_t size) const;
 
         virtual void* protect_alloc(std::size_t size, prot_flags flags) const = 0;
         virtual void protect_free(void* addr, std::size_t size) const = 0;
 
+        // Allocates exactly at addr, failing instead of replacing anything already mapped there
+        virtual void* protect_alloc_at(void* addr, std::size_t size, prot_flags flags) const;
+
+        // The region containing addr. An address outside of any mapping gives the unmapped gap from addr up to the
+        // next mapping, with prot_flags::NONE, like a free region on Windows. Returns false past the last mapping.
         virtual bool query_region(void* addr, region_info& region) const = 0;
+
+        // Appends the regions overlapping [addr, addr + size) in address order, clipped to that range
+        virtual bool query_regions(void* addr, std::size_t size, std::vector<region_info>& regions) const;
+
+        // Sets one byte per page of [addr, addr + size) to whether the page is resident. addr must be page aligned.
+        // Returns false when residency cannot be queried.
+        virtual bool query_residency(void* addr, std::size_t size, byte* resident) const;
+
         virtual prot_flags protect_query(void* addr) const = 0;
         virtual bool protect_modify(
             void* addr, std::size_t size, prot_flags flags, prot_flags* old_flags = nullptr) const = 0;
@@ -55,6 +73,68 @@ namespace mem
         virtual ~data_accessor() = default;
     };
 
+    inline bool data_accessor::query_regions(void* addr, std::size_t size, std::vector<region_info>& regions) const
+    {
+        const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(addr) + size;
+
+        for (std::uintptr_t current = reinterpret_cast<std::uintptr_t>(addr); current < end;)
+        {
+            region_info info {};
+
+            if (!query_region(reinterpret_cast<void*>(current), info))
+                return false;
+
+            const std::uintptr_t info_end = reinterpret_cast<std::uintptr_t>(info.start) + info.size;
+
+            if (info_end <= current)
+                return false;
+
+            info.start = reinterpret_cast<void*>(current);
+            info.size = std::min(info_end, end) - current;
+            regions.push_back(info);
+
+            current = info_end;
+        }
+
+        return true;
+    }
+
+    MEM_STRONG_INLINE bool data_accessor::query_residency(void*, std::size_t, byte*) const
+    {
+        return false;
+    }
+
+    inline std::size_t data_accessor::read_partial(void* src, void* dst, std::size_t size) const
+    {
+        if (read(src, dst, size))
+            return size;
+
+        // A failed read may not say how far it got, so go a page at a time.
+        // Pages are never smaller than this, so it still stops at the first page which cannot be read.
+        static constexpr const std::uintptr_t page {0x1000};
+
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(src);
+
+        std::size_t total = 0;
+
+        while (total < size)
+        {
+            const std::size_t length = (std::min)(size - total, page - ((start + total) & (page - 1)));
+
+            if (!read(reinterpret_cast<void*>(start + total), static_cast<byte*>(dst) + total, length))
+                break;
+
+            total += length;
+        }
+
+        return total;
+    }
+
+    MEM_STRONG_INLINE void* data_accessor::protect_alloc_at(void*, std::size_t, prot_flags) const
+    {
+        return nullptr;
+    }
+
     MEM_STRONG_INLINE bool data_accessor::fill(void* dst, byte value, std::size_t size) const
     {
         if (!dst || size == 0)
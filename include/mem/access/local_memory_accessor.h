@@ -51,7 +51,11 @@ namespace mem
         void* protect_alloc(std::size_t size, prot_flags flags) const override;
 
         void protect_free(void* addr, std::size_t size) const override;
+        void* protect_alloc_at(void* addr, std::size_t size, prot_flags flags) const override;
+
         bool query_region(void* addr, region_info& region) const override;
+        bool query_regions(void* addr, std::size_t size, std::vector<region_info>& regions) const override;
+        bool query_residency(void* addr, std::size_t size, byte* resident) const override;
 
         prot_flags protect_query(void* addr) const override;
 
@@ -105,11 +109,41 @@ namespace mem
             (void) size;
             ::VirtualFree(addr, 0, MEM_RELEASE);
 #elif defined(__unix__)
-            munmap(addr, length);
+            munmap(addr, size);
 #endif
         }
     }
 
+    MEM_STRONG_INLINE void* local_memory_accessor::protect_alloc_at(
+        void* addr, std::size_t size, prot_flags flags) const
+    {
+#if defined(_WIN32)
+        void* result = ::VirtualAlloc(addr, size, MEM_RESERVE | MEM_COMMIT, from_prot_flags(flags));
+        // The address is rounded down to the allocation granularity
+        if (result && (result != addr))
+        {
+            ::VirtualFree(result, 0, MEM_RELEASE);
+            return nullptr;
+        }
+        return result;
+#elif defined(__unix__)
+        int map_flags = MAP_ANONYMOUS | MAP_PRIVATE;
+#    if defined(MAP_FIXED_NOREPLACE)
+        map_flags |= MAP_FIXED_NOREPLACE;
+#    endif
+        void* result = mmap(addr, size, from_prot_flags(flags), map_flags, -1, 0);
+        if (result == MAP_FAILED)
+            return nullptr;
+        // Older kernels only take the address as a hint
+        if (result != addr)
+        {
+            munmap(result, size);
+            return nullptr;
+        }
+        return result;
+#endif
+    }
+
     MEM_STRONG_INLINE bool local_memory_accessor::query_region(void* addr, region_info& region) const
     {
 #if defined(_WIN32)
@@ -135,6 +169,42 @@ namespace mem
 #endif
     }
 
+    inline bool local_memory_accessor::query_regions(
+        void* addr, std::size_t size, std::vector<region_info>& regions) const
+    {
+#if defined(_WIN32)
+        return data_accessor::query_regions(addr, size, regions);
+#elif defined(__unix__)
+        // Only the mappings, from a single read of the maps
+        internal::regions_query query;
+        query.start = reinterpret_cast<std::uintptr_t>(addr);
+        query.end = query.start + size;
+        query.regions = &regions;
+
+        iter_proc_maps(&internal::regions_query_callback, &query);
+
+        return true;
+#endif
+    }
+
+    inline bool local_memory_accessor::query_residency(void* addr, std::size_t size, byte* resident) const
+    {
+#if defined(_WIN32)
+        return data_accessor::query_residency(addr, size, resident);
+#elif defined(__unix__)
+        if (mincore(addr, size, reinterpret_cast<unsigned char*>(resident)))
+            return false;
+
+        const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+        // Only the lowest bit is defined
+        for (std::size_t i = 0; i < (size + page - 1) / page; ++i)
+            resident[i] &= 1;
+
+        return true;
+#endif
+    }
+
     MEM_STRONG_INLINE prot_flags local_memory_accessor::protect_query(void* addr) const
     {
 #if defined(_WIN32)
@@ -8,6 +8,7 @@
 #        define _GNU_SOURCE
 #    endif
 #    include <cinttypes>
+#    include <cstdio>
 #    include <sys/mman.h>
 #    include <unistd.h>
 #endif
@@ -59,17 +60,53 @@ namespace mem
         inline int region_query_callback(vmem_area_t* vmem, void* data)
         {
             region_query* query = static_cast<region_query*>(data);
-            if ((query->address >= vmem->start) && (query->address < vmem->end))
+            if (query->address < vmem->end)
             {
                 auto& region = query->region;
-                region.start = reinterpret_cast<void*>(vmem->start);
-                region.size = vmem->start - vmem->end;
-                region.flags = to_prot_flags(vmem->prot);
+
+                if (query->address >= vmem->start)
+                {
+                    region.start = reinterpret_cast<void*>(vmem->start);
+                    region.size = vmem->end - vmem->start;
+                    region.flags = to_prot_flags(vmem->prot);
+                }
+                else
+                {
+                    // Unmapped gap before this mapping, reported like a free region on Windows
+                    region.start = reinterpret_cast<void*>(query->address);
+                    region.size = vmem->start - query->address;
+                    region.flags = prot_flags::NONE;
+                }
                 return 1;
             }
             return 0;
         }
 
+
+        struct regions_query
+        {
+            std::uintptr_t start;
+            std::uintptr_t end;
+            std::vector<region_info>* regions;
+        };
+
+        inline int regions_query_callback(vmem_area_t* vmem, void* data)
+        {
+            regions_query* query = static_cast<regions_query*>(data);
+
+            if (vmem->start >= query->end)
+                return 1;
+
+            if (vmem->end > query->start)
+            {
+                const std::uintptr_t start = std::max(vmem->start, query->start);
+                const std::uintptr_t end = std::min(vmem->end, query->end);
+
+                query->regions->push_back({reinterpret_cast<void*>(start), end - start, to_prot_flags(vmem->prot)});
+            }
+
+            return 0;
+        }
     } // namespace internal
 #endif
 
@@ -91,7 +128,7 @@ namespace mem
 
             while (std::fgets(buffer, 256, maps))
             {
-                int count = std::sscanf(buffer, "%" SCNxPTR "-%" SCNxPTR " %4s %zx %*x:%*x %*u %255s", &region.start,
+                int count = std::sscanf(buffer, "%" SCNxPTR "-%" SCNxPTR " %4s %zx %*x:%*x %*u %255s", &vmem.start,
                     &vmem.end, perms, &vmem.offset, pathname);
 
                 if (count < 4)
@@ -71,6 +71,7 @@ namespace mem
         void* protect_alloc(std::size_t size, prot_flags flags) const override;
 
         void protect_free(void* addr, std::size_t size) const override;
+        void* protect_alloc_at(void* addr, std::size_t size, prot_flags flags) const override;
 
         bool query_region(void* addr, region_info& region) const override;
 
@@ -164,6 +165,19 @@ namespace mem
         ::VirtualFreeEx(process_handle_, addr, 0, MEM_RELEASE);
     }
 
+    MEM_STRONG_INLINE void* remote_memory_accessor::protect_alloc_at(
+        void* addr, std::size_t size, prot_flags flags) const
+    {
+        void* result = ::VirtualAllocEx(process_handle_, addr, size, MEM_COMMIT | MEM_RESERVE, from_prot_flags(flags));
+        // The address is rounded down to the allocation granularity
+        if (result && (result != addr))
+        {
+            ::VirtualFreeEx(process_handle_, result, 0, MEM_RELEASE);
+            return nullptr;
+        }
+        return result;
+    }
+
     MEM_STRONG_INLINE bool remote_memory_accessor::query_region(void* addr, region_info& region) const
     {
         MEMORY_BASIC_INFORMATION info;
@@ -42,7 +42,7 @@ namespace mem
 #elif (_POSIX_C_SOURCE >= 200112L)
         void* result = nullptr;
 
-        if (posix_memalign(&result, size, alignment) != 0)
+        if (posix_memalign(&result, alignment, size) != 0)
         {
             return nullptr;
         }
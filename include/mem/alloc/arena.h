@@ -0,0 +1,387 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_ARENA_BRICK_H
+#define MEM_ARENA_BRICK_H
+
+#include <mem/memory/protect.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace mem
+{
+    static constexpr const std::size_t default_arena_chunk_size {0x10000};
+
+    // A bump allocator over page aligned chunks from protect_alloc.
+    // Allocations are never freed one by one, only all together through reset or release.
+    class arena
+    {
+    private:
+        struct chunk
+        {
+            chunk* previous;
+            std::size_t size; // Including this header
+        };
+
+        chunk* chunks_ {nullptr}; // Most recent first
+        chunk* spare_ {nullptr};  // A chunk of the default size kept by reset for reuse
+
+        std::uintptr_t current_ {0};
+        std::uintptr_t end_ {0};
+
+        std::size_t chunk_size_ {default_arena_chunk_size};
+        std::size_t reserved_ {0};
+
+        void* allocate_slow(std::size_t size, std::size_t alignment);
+
+        chunk* new_chunk(std::size_t size);
+        void free_chunk(chunk* value) noexcept;
+
+    public:
+        // A position in the arena to reset back to
+        class marker
+        {
+        private:
+            friend class arena;
+
+            const void* chunk_ {nullptr};
+            std::uintptr_t current_ {0};
+        };
+
+        // Chunk sizes are rounded up to whole pages
+        explicit arena(std::size_t chunk_size = default_arena_chunk_size);
+        ~arena();
+
+        arena(arena&& rhs) noexcept;
+        arena& operator=(arena&& rhs) noexcept;
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        // Throws std::bad_alloc when no more pages can be allocated
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        template <typename T>
+        T* allocate_array(std::size_t count);
+
+        marker mark() const noexcept;
+
+        // Frees everything allocated since position was marked
+        void reset(marker position) noexcept;
+
+        // Frees everything, keeping one chunk for the next allocations
+        void reset() noexcept;
+
+        // Frees everything and returns all of the chunks
+        void release() noexcept;
+
+        // Bytes currently held in chunks
+        std::size_t reserved() const noexcept;
+    };
+
+    // A standard allocator which allocates from an arena, or from the global heap without one.
+    // Deallocation is a no-op for arena memory.
+    template <typename T>
+    class arena_allocator
+    {
+    private:
+        template <typename U>
+        friend class arena_allocator;
+
+        arena* arena_ {nullptr};
+
+    public:
+        using value_type = T;
+
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        arena_allocator() noexcept = default;
+        arena_allocator(arena& storage) noexcept;
+
+        template <typename U>
+        arena_allocator(const arena_allocator<U>& rhs) noexcept;
+
+        T* allocate(std::size_t count);
+        void deallocate(T* values, std::size_t count) noexcept;
+
+        arena* get_arena() const noexcept;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept;
+
+    template <typename T, typename U>
+    bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept;
+
+    template <typename T>
+    using arena_vector = std::vector<T, arena_allocator<T>>;
+
+    inline arena::arena(std::size_t chunk_size)
+    {
+        const std::size_t page = page_size();
+
+        chunk_size_ = (chunk_size + page - 1) / page * page;
+
+        if (chunk_size_ < page)
+            chunk_size_ = page;
+    }
+
+    inline arena::~arena()
+    {
+        release();
+    }
+
+    inline arena::arena(arena&& rhs) noexcept
+        : chunks_(rhs.chunks_)
+        , spare_(rhs.spare_)
+        , current_(rhs.current_)
+        , end_(rhs.end_)
+        , chunk_size_(rhs.chunk_size_)
+        , reserved_(rhs.reserved_)
+    {
+        rhs.chunks_ = nullptr;
+        rhs.spare_ = nullptr;
+        rhs.current_ = 0;
+        rhs.end_ = 0;
+        rhs.reserved_ = 0;
+    }
+
+    inline arena& arena::operator=(arena&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            release();
+
+            chunks_ = rhs.chunks_;
+            spare_ = rhs.spare_;
+            current_ = rhs.current_;
+            end_ = rhs.end_;
+            chunk_size_ = rhs.chunk_size_;
+            reserved_ = rhs.reserved_;
+
+            rhs.chunks_ = nullptr;
+            rhs.spare_ = nullptr;
+            rhs.current_ = 0;
+            rhs.end_ = 0;
+            rhs.reserved_ = 0;
+        }
+
+        return *this;
+    }
+
+    MEM_STRONG_INLINE void* arena::allocate(std::size_t size, std::size_t alignment)
+    {
+        const std::uintptr_t result = (current_ + alignment - 1) & ~(alignment - 1);
+
+        if (MEM_LIKELY(current_ && (result <= end_) && (size <= end_ - result)))
+        {
+            current_ = result + size;
+
+            return reinterpret_cast<void*>(result);
+        }
+
+        return allocate_slow(size, alignment);
+    }
+
+    template <typename T>
+    MEM_STRONG_INLINE T* arena::allocate_array(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena values are never destroyed");
+
+        if (count > SIZE_MAX / sizeof(T))
+            throw std::bad_alloc();
+
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    inline void* arena::allocate_slow(std::size_t size, std::size_t alignment)
+    {
+        // Enough for the header, the value, and aligning the value
+        const std::size_t header = sizeof(chunk) + alignment - 1;
+
+        if (size > SIZE_MAX - header - chunk_size_)
+            throw std::bad_alloc();
+
+        const std::size_t page = page_size();
+        const std::size_t needed = (header + size + page - 1) / page * page;
+
+        chunk* const value = new_chunk((needed > chunk_size_) ? needed : chunk_size_);
+
+        value->previous = chunks_;
+        chunks_ = value;
+
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(value);
+        const std::uintptr_t result = (start + sizeof(chunk) + alignment - 1) & ~(alignment - 1);
+
+        current_ = result + size;
+        end_ = start + value->size;
+
+        return reinterpret_cast<void*>(result);
+    }
+
+    inline arena::chunk* arena::new_chunk(std::size_t size)
+    {
+        if ((size == chunk_size_) && spare_)
+        {
+            chunk* const result = spare_;
+            spare_ = nullptr;
+
+            return result;
+        }
+
+        void* const memory = protect_alloc(size, prot_flags::RW);
+
+        if (!memory)
+            throw std::bad_alloc();
+
+        reserved_ += size;
+
+        chunk* const result = static_cast<chunk*>(memory);
+        result->previous = nullptr;
+        result->size = size;
+
+        return result;
+    }
+
+    inline void arena::free_chunk(chunk* value) noexcept
+    {
+        if ((value->size == chunk_size_) && !spare_)
+        {
+            spare_ = value;
+
+            return;
+        }
+
+        reserved_ -= value->size;
+
+        protect_free(value, value->size);
+    }
+
+    MEM_STRONG_INLINE arena::marker arena::mark() const noexcept
+    {
+        marker result;
+
+        result.chunk_ = chunks_;
+        result.current_ = current_;
+
+        return result;
+    }
+
+    inline void arena::reset(marker position) noexcept
+    {
+        while (chunks_ && (chunks_ != position.chunk_))
+        {
+            chunk* const previous = chunks_->previous;
+
+            free_chunk(chunks_);
+
+            chunks_ = previous;
+        }
+
+        if (chunks_)
+        {
+            current_ = position.current_;
+            end_ = reinterpret_cast<std::uintptr_t>(chunks_) + chunks_->size;
+        }
+        else
+        {
+            current_ = 0;
+            end_ = 0;
+        }
+    }
+
+    inline void arena::reset() noexcept
+    {
+        reset(marker());
+    }
+
+    inline void arena::release() noexcept
+    {
+        reset();
+
+        if (spare_)
+        {
+            reserved_ -= spare_->size;
+
+            protect_free(spare_, spare_->size);
+
+            spare_ = nullptr;
+        }
+    }
+
+    MEM_STRONG_INLINE std::size_t arena::reserved() const noexcept
+    {
+        return reserved_;
+    }
+
+    template <typename T>
+    MEM_STRONG_INLINE arena_allocator<T>::arena_allocator(arena& storage) noexcept
+        : arena_(&storage)
+    {}
+
+    template <typename T>
+    template <typename U>
+    MEM_STRONG_INLINE arena_allocator<T>::arena_allocator(const arena_allocator<U>& rhs) noexcept
+        : arena_(rhs.arena_)
+    {}
+
+    template <typename T>
+    MEM_STRONG_INLINE T* arena_allocator<T>::allocate(std::size_t count)
+    {
+        if (count > SIZE_MAX / sizeof(T))
+            throw std::bad_alloc();
+
+        if (arena_)
+            return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    template <typename T>
+    MEM_STRONG_INLINE void arena_allocator<T>::deallocate(T* values, std::size_t) noexcept
+    {
+        if (!arena_)
+            ::operator delete(values);
+    }
+
+    template <typename T>
+    MEM_STRONG_INLINE arena* arena_allocator<T>::get_arena() const noexcept
+    {
+        return arena_;
+    }
+
+    template <typename T, typename U>
+    MEM_STRONG_INLINE bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+    {
+        return lhs.get_arena() == rhs.get_arena();
+    }
+
+    template <typename T, typename U>
+    MEM_STRONG_INLINE bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+    {
+        return lhs.get_arena() != rhs.get_arena();
+    }
+} // namespace mem
+
+#endif // MEM_ARENA_BRICK_H
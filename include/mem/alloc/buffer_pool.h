@@ -0,0 +1,376 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_BUFFER_POOL_BRICK_H
+#define MEM_BUFFER_POOL_BRICK_H
+
+#include <mem/core/defines.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#    if !defined(WIN32_LEAN_AND_MEAN)
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <Windows.h>
+#elif defined(__unix__)
+#    include <sys/mman.h>
+#    include <unistd.h>
+#else
+#    error Unknown Platform
+#endif
+
+namespace mem
+{
+    enum class buffer_pages
+    {
+        normal,           // Regular pages
+        transparent_huge, // Regular pages, which the kernel is asked to back with huge pages where it can
+        huge_tlb,         // Reserved huge pages, falling back to transparent_huge when none are available
+    };
+
+    // The size of a huge page, which buffers of huge pages are rounded up to and aligned on.
+    // On Linux this is the transparent huge page size the kernel reports, such as 2 MB on x86-64 or 512 MB on
+    // arm64 with 64 KB pages. On Windows it is the large page minimum. Both fall back to 2 MB.
+    inline std::size_t huge_page_size()
+    {
+        static const std::size_t size = [] {
+            std::size_t result = 0;
+
+#if defined(_WIN32)
+            result = GetLargePageMinimum();
+#elif defined(__unix__)
+            if (std::FILE* file = std::fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r"))
+            {
+                if (std::fscanf(file, "%zu", &result) != 1)
+                    result = 0;
+
+                std::fclose(file);
+            }
+#endif
+
+            // Must be a power of two for the buffers to be aligned on it
+            if ((result == 0) || (result & (result - 1)))
+                result = 0x200000;
+
+            return result;
+        }();
+
+        return size;
+    }
+
+    // Large, uninitialized, page aligned buffers which are kept mapped for reuse.
+    // Reused buffers are already faulted in, so repeated scans skip both the zeroing and the page faults.
+    class buffer_pool
+    {
+    private:
+        struct block
+        {
+            byte* data {nullptr};
+            std::size_t size {0};
+        };
+
+        std::vector<block> free_ {};
+
+        buffer_pages pages_ {buffer_pages::normal};
+        std::size_t max_cached_ {4};
+
+        static block allocate_block(std::size_t size, buffer_pages pages);
+        static void free_block(block value) noexcept;
+
+        void recycle(block value) noexcept;
+
+    public:
+        // A buffer taken from a pool, which goes back to it when destroyed
+        class buffer
+        {
+        private:
+            friend class buffer_pool;
+
+            buffer_pool* pool_ {nullptr};
+            block block_ {};
+
+            buffer(buffer_pool* pool, block value) noexcept;
+
+        public:
+            buffer() noexcept = default;
+            ~buffer();
+
+            buffer(buffer&& rhs) noexcept;
+            buffer& operator=(buffer&& rhs) noexcept;
+
+            buffer(const buffer&) = delete;
+            buffer& operator=(const buffer&) = delete;
+
+            byte* data() const noexcept;
+
+            // At least the requested size
+            std::size_t size() const noexcept;
+
+            explicit operator bool() const noexcept;
+        };
+
+        explicit buffer_pool(buffer_pages pages = buffer_pages::normal, std::size_t max_cached = 4);
+        ~buffer_pool();
+
+        buffer_pool(const buffer_pool&) = delete;
+        buffer_pool& operator=(const buffer_pool&) = delete;
+
+        // Reuses the smallest cached buffer which is large enough, or maps a new one.
+        // Throws std::bad_alloc when no memory can be mapped.
+        buffer acquire(std::size_t size);
+
+        // Unmaps every cached buffer
+        void trim() noexcept;
+
+        std::size_t cached() const noexcept;
+
+        // A pool of normal pages for the calling thread
+        static buffer_pool& thread_pool();
+    };
+
+    inline buffer_pool::block buffer_pool::allocate_block(std::size_t size, buffer_pages pages)
+    {
+        block result;
+
+#if defined(_WIN32)
+        if (pages == buffer_pages::huge_tlb)
+        {
+            // Needs SeLockMemoryPrivilege, which most processes do not have
+            if (const std::size_t large_page = GetLargePageMinimum())
+            {
+                const std::size_t large_size = (size + large_page - 1) / large_page * large_page;
+
+                if (void* data = VirtualAlloc(
+                        nullptr, large_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+                {
+                    result.data = static_cast<byte*>(data);
+                    result.size = large_size;
+
+                    return result;
+                }
+            }
+        }
+
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        const std::size_t page = info.dwPageSize;
+
+        result.size = (size + page - 1) / page * page;
+        result.data =
+            static_cast<byte*>(VirtualAlloc(nullptr, result.size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#elif defined(__unix__)
+        const std::size_t page =
+            (pages == buffer_pages::normal) ? static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) : huge_page_size();
+
+        result.size = (size + page - 1) / page * page;
+
+        void* data = MAP_FAILED;
+
+#    if defined(MAP_HUGETLB)
+        if (pages == buffer_pages::huge_tlb)
+            data = mmap(nullptr, result.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#    endif
+
+        if ((data == MAP_FAILED) && (pages == buffer_pages::normal))
+        {
+            data = mmap(nullptr, result.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        else if (data == MAP_FAILED)
+        {
+            // Only whole, aligned huge pages can be backed by one, so map an extra page and trim it to alignment
+            const std::size_t mapped = result.size + page;
+
+            data = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (data != MAP_FAILED)
+            {
+                byte* const start = static_cast<byte*>(data);
+                byte* const aligned = reinterpret_cast<byte*>(
+                    (reinterpret_cast<std::uintptr_t>(start) + page - 1) & ~static_cast<std::uintptr_t>(page - 1));
+
+                if (aligned != start)
+                    munmap(start, static_cast<std::size_t>(aligned - start));
+
+                if (aligned + result.size != start + mapped)
+                    munmap(aligned + result.size, static_cast<std::size_t>(start + mapped - (aligned + result.size)));
+
+                data = aligned;
+
+#    if defined(MADV_HUGEPAGE)
+                madvise(data, result.size, MADV_HUGEPAGE);
+#    endif
+            }
+        }
+
+        result.data = (data != MAP_FAILED) ? static_cast<byte*>(data) : nullptr;
+#endif
+
+        if (!result.data)
+            throw std::bad_alloc();
+
+        return result;
+    }
+
+    inline void buffer_pool::free_block(block value) noexcept
+    {
+#if defined(_WIN32)
+        VirtualFree(value.data, 0, MEM_RELEASE);
+#elif defined(__unix__)
+        munmap(value.data, value.size);
+#endif
+    }
+
+    inline void buffer_pool::recycle(block value) noexcept
+    {
+        if (free_.size() < max_cached_)
+        {
+            // Capacity is reserved up front, so this never allocates
+            free_.push_back(value);
+
+            return;
+        }
+
+        // Keep the larger buffers, which can serve any request the smaller ones could
+        std::size_t smallest = 0;
+
+        for (std::size_t i = 1; i < free_.size(); ++i)
+        {
+            if (free_[i].size < free_[smallest].size)
+                smallest = i;
+        }
+
+        if (!free_.empty() && (free_[smallest].size < value.size))
+            std::swap(free_[smallest], value);
+
+        free_block(value);
+    }
+
+    inline buffer_pool::buffer_pool(buffer_pages pages, std::size_t max_cached)
+        : pages_(pages)
+        , max_cached_(max_cached)
+    {
+        free_.reserve(max_cached_);
+    }
+
+    inline buffer_pool::~buffer_pool()
+    {
+        trim();
+    }
+
+    inline buffer_pool::buffer buffer_pool::acquire(std::size_t size)
+    {
+        std::size_t best = SIZE_MAX;
+
+        for (std::size_t i = 0; i < free_.size(); ++i)
+        {
+            if ((free_[i].size >= size) && ((best == SIZE_MAX) || (free_[i].size < free_[best].size)))
+                best = i;
+        }
+
+        if (best != SIZE_MAX)
+        {
+            const block result = free_[best];
+
+            free_[best] = free_.back();
+            free_.pop_back();
+
+            return buffer(this, result);
+        }
+
+        return buffer(this, allocate_block(size ? size : 1, pages_));
+    }
+
+    inline void buffer_pool::trim() noexcept
+    {
+        for (const block& value : free_)
+            free_block(value);
+
+        free_.clear();
+    }
+
+    MEM_STRONG_INLINE std::size_t buffer_pool::cached() const noexcept
+    {
+        return free_.size();
+    }
+
+    inline buffer_pool& buffer_pool::thread_pool()
+    {
+        static thread_local buffer_pool instance;
+
+        return instance;
+    }
+
+    MEM_STRONG_INLINE buffer_pool::buffer::buffer(buffer_pool* pool, block value) noexcept
+        : pool_(pool)
+        , block_(value)
+    {}
+
+    inline buffer_pool::buffer::~buffer()
+    {
+        if (block_.data)
+            pool_->recycle(block_);
+    }
+
+    inline buffer_pool::buffer::buffer(buffer&& rhs) noexcept
+        : pool_(rhs.pool_)
+        , block_(rhs.block_)
+    {
+        rhs.block_ = {};
+    }
+
+    inline buffer_pool::buffer& buffer_pool::buffer::operator=(buffer&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            if (block_.data)
+                pool_->recycle(block_);
+
+            pool_ = rhs.pool_;
+            block_ = rhs.block_;
+
+            rhs.block_ = {};
+        }
+
+        return *this;
+    }
+
+    MEM_STRONG_INLINE byte* buffer_pool::buffer::data() const noexcept
+    {
+        return block_.data;
+    }
+
+    MEM_STRONG_INLINE std::size_t buffer_pool::buffer::size() const noexcept
+    {
+        return block_.size;
+    }
+
+    MEM_STRONG_INLINE buffer_pool::buffer::operator bool() const noexcept
+    {
+        return block_.data != nullptr;
+    }
+} // namespace mem
+
+#endif // MEM_BUFFER_POOL_BRICK_H
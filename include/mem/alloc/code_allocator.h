@@ -0,0 +1,400 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_CODE_ALLOCATOR_BRICK_H
+#define MEM_CODE_ALLOCATOR_BRICK_H
+
+#include <mem/memory/protect.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mem
+{
+    // Furthest a rel32 displacement can reach, leaving room for the instruction itself
+    static constexpr const std::size_t default_code_distance {0x7FFF0000};
+
+    // Carves small executable stubs out of shared blocks, placed near a target when asked.
+    //
+    // Blocks are mapped read and execute. write makes a block writable, copies the code and makes it executable
+    // again. Inside a batch, blocks stay writable until the batch ends, and are then flipped back together, with
+    // neighbouring blocks sharing one protection change.
+    //
+    // A writable block is not executable, so every stub in it faults when run until the block is executable again.
+    // Only write while no other thread can run a stub from the same block, such as before any of them is installed.
+    class code_allocator
+    {
+    private:
+        struct block
+        {
+            std::uintptr_t start;
+            std::size_t size;
+            std::size_t used;
+            bool writable;
+        };
+
+        struct stub
+        {
+            std::uintptr_t start;
+            std::size_t size;
+        };
+
+        data_accessor* accessor_ {nullptr};
+
+        std::vector<block> blocks_ {};
+        std::vector<stub> free_ {};
+
+        std::size_t block_size_ {0};
+        std::size_t granularity_ {0};
+        std::size_t max_distance_ {default_code_distance};
+
+        std::size_t batch_depth_ {0};
+
+        bool in_range(std::uintptr_t start, std::size_t size, std::uintptr_t target) const noexcept;
+
+        // Maps size bytes within max_distance_ of target, searching the free address space outwards from it
+        std::uintptr_t map_near(std::uintptr_t target, std::size_t size);
+        std::uintptr_t try_map(std::uintptr_t address, std::size_t size);
+
+        block* find_block(std::uintptr_t address) noexcept;
+
+        bool make_writable(block& value);
+        bool make_executable();
+
+    public:
+        class batch
+        {
+        private:
+            code_allocator* allocator_ {nullptr};
+
+        public:
+            explicit batch(code_allocator& allocator);
+            ~batch();
+
+            batch(const batch&) = delete;
+            batch& operator=(const batch&) = delete;
+        };
+
+        explicit code_allocator(data_accessor& accessor = get_default_accessor(), std::size_t block_size = 0x10000,
+            std::size_t max_distance = default_code_distance);
+        ~code_allocator();
+
+        code_allocator(const code_allocator&) = delete;
+        code_allocator& operator=(const code_allocator&) = delete;
+
+        // A stub of size bytes, which is reachable from hint by a rel32 displacement when hint is not null.
+        // Returns nullptr when no such memory can be found.
+        void* allocate(std::size_t size, const void* hint = nullptr, std::size_t alignment = 16);
+
+        // Makes a stub available to later allocations of the same or a smaller size
+        void deallocate(void* address, std::size_t size);
+
+        // Copies code into memory returned by allocate.
+        // Other stubs in the same block cannot run until the write, or the batch it is part of, ends.
+        bool write(void* address, const void* code, std::size_t size);
+
+        // Defers making written blocks executable until the matching end_batch
+        void begin_batch() noexcept;
+        bool end_batch();
+
+        // Number of blocks mapped so far
+        std::size_t block_count() const noexcept;
+    };
+
+    inline code_allocator::code_allocator(data_accessor& accessor, std::size_t block_size, std::size_t max_distance)
+        : accessor_(&accessor)
+        , max_distance_(max_distance)
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        // Allocations on Windows start on this boundary, even though pages are smaller
+        granularity_ = info.dwAllocationGranularity;
+#else
+        granularity_ = page_size();
+#endif
+
+        block_size_ = (std::max)((block_size + granularity_ - 1) / granularity_ * granularity_, granularity_);
+    }
+
+    inline code_allocator::~code_allocator()
+    {
+        for (const block& value : blocks_)
+            accessor_->protect_free(reinterpret_cast<void*>(value.start), value.size);
+    }
+
+    MEM_STRONG_INLINE bool code_allocator::in_range(
+        std::uintptr_t start, std::size_t size, std::uintptr_t target) const noexcept
+    {
+        const std::uintptr_t end = start + size;
+
+        return ((start < target) ? (target - start) : (start - target)) <= max_distance_ &&
+            ((end < target) ? (target - end) : (end - target)) <= max_distance_;
+    }
+
+    inline std::uintptr_t code_allocator::try_map(std::uintptr_t address, std::size_t size)
+    {
+        return reinterpret_cast<std::uintptr_t>(
+            accessor_->protect_alloc_at(reinterpret_cast<void*>(address), size, prot_flags::RX));
+    }
+
+    inline std::uintptr_t code_allocator::map_near(std::uintptr_t target, std::size_t size)
+    {
+        const std::uintptr_t mask = ~static_cast<std::uintptr_t>(granularity_ - 1);
+
+        // Keep the first pages unmapped, so null pointers still fault
+        const std::uintptr_t lowest = (std::max)(
+            (target > max_distance_) ? target - max_distance_ : 0, static_cast<std::uintptr_t>(0x10000));
+        const std::uintptr_t highest =
+            (UINTPTR_MAX - target > max_distance_) ? target + max_distance_ : UINTPTR_MAX;
+
+        // Upwards, jumping over each mapping
+        for (std::uintptr_t current = (target + granularity_ - 1) & mask;
+             (current >= target) && (current <= highest - size);)
+        {
+            region_info info {};
+
+            // Past the last mapping
+            if (!accessor_->query_region(reinterpret_cast<void*>(current), info))
+            {
+                if (const std::uintptr_t result = try_map(current, size))
+                    return result;
+
+                break;
+            }
+
+            const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(info.start);
+            const std::uintptr_t end = start + info.size;
+
+            if ((info.flags == prot_flags::NONE) && (end - current >= size))
+            {
+                if (const std::uintptr_t result = try_map(current, size))
+                    return result;
+            }
+
+            const std::uintptr_t next = ((end > current ? end : current + 1) + granularity_ - 1) & mask;
+
+            if (next <= current)
+                break;
+
+            current = next;
+        }
+
+        // Downwards, ending each attempt just below the mapping in the way
+        for (std::uintptr_t current = (target - (std::min)(target, size)) & mask; current >= lowest;)
+        {
+            region_info info {};
+
+            if (!accessor_->query_region(reinterpret_cast<void*>(current), info))
+                break;
+
+            const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(info.start);
+            const std::uintptr_t end = start + info.size;
+
+            std::uintptr_t limit = start;
+
+            if (info.flags == prot_flags::NONE)
+            {
+                if (end - current >= size)
+                {
+                    if (const std::uintptr_t result = try_map(current, size))
+                        return result;
+                }
+                else
+                {
+                    // Too small, so the next mapping starts at end
+                    limit = end;
+                }
+            }
+
+            if (limit < size + lowest)
+                break;
+
+            const std::uintptr_t next = (limit - size) & mask;
+
+            current = (next < current) ? next : current - granularity_;
+        }
+
+        return 0;
+    }
+
+    inline code_allocator::block* code_allocator::find_block(std::uintptr_t address) noexcept
+    {
+        for (block& value : blocks_)
+        {
+            if ((address >= value.start) && (address - value.start < value.size))
+                return &value;
+        }
+
+        return nullptr;
+    }
+
+    inline void* code_allocator::allocate(std::size_t size, const void* hint, std::size_t alignment)
+    {
+        if (!size || (alignment & (alignment - 1)))
+            return nullptr;
+
+        const std::uintptr_t target = reinterpret_cast<std::uintptr_t>(hint);
+
+        for (std::size_t i = 0; i < free_.size(); ++i)
+        {
+            const stub value = free_[i];
+
+            if ((value.size >= size) && !(value.start & (alignment - 1)) &&
+                (!hint || in_range(value.start, size, target)))
+            {
+                free_[i] = free_.back();
+                free_.pop_back();
+
+                return reinterpret_cast<void*>(value.start);
+            }
+        }
+
+        for (block& value : blocks_)
+        {
+            const std::uintptr_t start = (value.start + value.used + alignment - 1) & ~(alignment - 1);
+
+            if ((start + size <= value.start + value.size) && (!hint || in_range(start, size, target)))
+            {
+                value.used = start + size - value.start;
+
+                return reinterpret_cast<void*>(start);
+            }
+        }
+
+        const std::size_t length = (std::max)((size + granularity_ - 1) / granularity_ * granularity_, block_size_);
+
+        const std::uintptr_t start = hint
+            ? map_near(target, length)
+            : reinterpret_cast<std::uintptr_t>(accessor_->protect_alloc(length, prot_flags::RX));
+
+        if (!start)
+            return nullptr;
+
+        blocks_.push_back({start, length, size, false});
+
+        return reinterpret_cast<void*>(start);
+    }
+
+    inline void code_allocator::deallocate(void* address, std::size_t size)
+    {
+        if (address && size)
+            free_.push_back({reinterpret_cast<std::uintptr_t>(address), size});
+    }
+
+    inline bool code_allocator::make_writable(block& value)
+    {
+        if (value.writable)
+            return true;
+
+        value.writable =
+            accessor_->protect_modify(reinterpret_cast<void*>(value.start), value.size, prot_flags::RW, nullptr);
+
+        return value.writable;
+    }
+
+    inline bool code_allocator::make_executable()
+    {
+        std::vector<block*> writable;
+
+        for (block& value : blocks_)
+        {
+            if (value.writable)
+                writable.push_back(&value);
+        }
+
+        std::sort(writable.begin(), writable.end(), [](const block* lhs, const block* rhs) {
+            return lhs->start < rhs->start;
+        });
+
+        bool success = true;
+
+        for (std::size_t i = 0; i < writable.size();)
+        {
+            const std::uintptr_t start = writable[i]->start;
+            std::uintptr_t end = start + writable[i]->size;
+
+            std::size_t j = i + 1;
+
+            // Blocks mapped back to back are changed together
+            for (; (j < writable.size()) && (writable[j]->start == end); ++j)
+                end += writable[j]->size;
+
+            const bool changed =
+                accessor_->protect_modify(reinterpret_cast<void*>(start), end - start, prot_flags::RX, nullptr);
+
+            for (; i < j; ++i)
+                writable[i]->writable = !changed;
+
+            success &= changed;
+        }
+
+        return success;
+    }
+
+    inline bool code_allocator::write(void* address, const void* code, std::size_t size)
+    {
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(address);
+
+        block* const value = find_block(start);
+
+        if (!value || (size > value->size - (start - value->start)) || !make_writable(*value))
+            return false;
+
+        const bool success = accessor_->write(address, const_cast<void*>(code), size);
+
+        if (!batch_depth_)
+            return make_executable() && success;
+
+        return success;
+    }
+
+    MEM_STRONG_INLINE void code_allocator::begin_batch() noexcept
+    {
+        ++batch_depth_;
+    }
+
+    inline bool code_allocator::end_batch()
+    {
+        if (batch_depth_ && --batch_depth_)
+            return true;
+
+        return make_executable();
+    }
+
+    MEM_STRONG_INLINE std::size_t code_allocator::block_count() const noexcept
+    {
+        return blocks_.size();
+    }
+
+    inline code_allocator::batch::batch(code_allocator& allocator)
+        : allocator_(&allocator)
+    {
+        allocator_->begin_batch();
+    }
+
+    inline code_allocator::batch::~batch()
+    {
+        allocator_->end_batch();
+    }
+} // namespace mem
+
+#endif // MEM_CODE_ALLOCATOR_BRICK_H
@@ -20,8 +20,10 @@
 #ifndef MEM_DATA_BUFFER_BRICK_H
 #define MEM_DATA_BUFFER_BRICK_H
 
+#include <mem/alloc/aligned_alloc.h>
 #include <mem/core/defines.h>
 
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 
@@ -29,18 +31,72 @@
 
 namespace mem
 {
-    template <typename T>
-    class data_buffer
+    namespace internal
+    {
+        template <typename T, std::size_t Capacity, std::size_t Alignment>
+        class inline_storage
+        {
+        private:
+            alignas(Alignment) T values_[Capacity];
+
+        public:
+            T* inline_data() noexcept
+            {
+                return values_;
+            }
+
+            const T* inline_data() const noexcept
+            {
+                return values_;
+            }
+        };
+
+        template <typename T, std::size_t Alignment>
+        class inline_storage<T, 0, Alignment>
+        {
+        public:
+            T* inline_data() noexcept
+            {
+                return nullptr;
+            }
+
+            const T* inline_data() const noexcept
+            {
+                return nullptr;
+            }
+        };
+    } // namespace internal
+
+    // A growable array of trivial values.
+    // Up to InlineCapacity values are stored inside the buffer itself, and the data is always aligned to Alignment.
+    template <typename T, std::size_t InlineCapacity = 0, std::size_t Alignment = alignof(T)>
+    class data_buffer : private internal::inline_storage<T, InlineCapacity, Alignment>
     {
     private:
         static_assert(std::is_trivial<T>::value, "Type is not trivially copyable");
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment is not a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment is too small");
 
-        T* data_ {nullptr};
+        using storage = internal::inline_storage<T, InlineCapacity, Alignment>;
+
+        // Heap blocks from malloc already have this alignment, and can grow in place with realloc
+        static constexpr const bool over_aligned {Alignment > alignof(std::max_align_t)};
+
+        // Smallest heap allocation, to avoid several tiny reallocations while a buffer starts filling up
+        static constexpr const std::size_t min_capacity {(64 / sizeof(T)) ? (64 / sizeof(T)) : 1};
+
+        T* data_ {storage::inline_data()};
         std::size_t size_ {0};
-        std::size_t capacity_ {0};
+        std::size_t capacity_ {InlineCapacity};
+
+        bool is_inline() const noexcept;
 
         std::size_t calculate_growth(std::size_t new_size) const noexcept;
         void reallocate(std::size_t length);
+        void release() noexcept;
+
+        // Moves the values of other into this empty buffer, leaving other empty
+        void take(data_buffer& other) noexcept;
 
     public:
         data_buffer() noexcept = default;
@@ -53,14 +109,20 @@ namespace mem
         ~data_buffer();
 
         data_buffer& operator=(const data_buffer& other);
-        data_buffer& operator=(data_buffer&& other);
+        data_buffer& operator=(data_buffer&& other) noexcept;
 
         void swap(data_buffer& other) noexcept;
 
         void reserve(std::size_t length);
+
+        // New values are zeroed
         void resize(std::size_t length);
         void reset(std::size_t length = 0);
 
+        // New values are left uninitialized, to be written directly by the caller
+        void resize_uninitialized(std::size_t length);
+        T* append_uninitialized(std::size_t length);
+
         void assign(const T* source, std::size_t length);
         void append(const T* source, std::size_t length);
 
@@ -97,42 +159,40 @@ namespace mem
 
         using iterator = value_type*;
         using const_iterator = const value_type*;
+
+        static constexpr const std::size_t inline_capacity {InlineCapacity};
+        static constexpr const std::size_t alignment {Alignment};
     };
 
     using byte_buffer = data_buffer<byte>;
 
-    template <typename T>
-    inline data_buffer<T>::data_buffer(std::size_t length)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline data_buffer<T, InlineCapacity, Alignment>::data_buffer(std::size_t length)
     {
         resize(length);
     }
 
-    template <typename T>
-    inline data_buffer<T>::data_buffer(const data_buffer<T>& other)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline data_buffer<T, InlineCapacity, Alignment>::data_buffer(const data_buffer& other)
     {
-        if (this != &other)
-        {
-            assign(other.data(), other.size());
-        }
+        assign(other.data(), other.size());
     }
 
-    template <typename T>
-    inline data_buffer<T>::data_buffer(data_buffer<T>&& other) noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline data_buffer<T, InlineCapacity, Alignment>::data_buffer(data_buffer&& other) noexcept
     {
-        if (this != &other)
-        {
-            swap(other);
-        }
+        take(other);
     }
 
-    template <typename T>
-    inline data_buffer<T>::~data_buffer()
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline data_buffer<T, InlineCapacity, Alignment>::~data_buffer()
     {
-        clear();
+        release();
     }
 
-    template <typename T>
-    inline data_buffer<T>& data_buffer<T>::operator=(const data_buffer<T>& other)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline data_buffer<T, InlineCapacity, Alignment>& data_buffer<T, InlineCapacity, Alignment>::operator=(
+        const data_buffer& other)
     {
         if (this != &other)
         {
@@ -142,21 +202,29 @@ namespace mem
         return *this;
     }
 
-    template <typename T>
-    inline data_buffer<T>& data_buffer<T>::operator=(data_buffer<T>&& other)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline data_buffer<T, InlineCapacity, Alignment>& data_buffer<T, InlineCapacity, Alignment>::operator=(
+        data_buffer&& other) noexcept
     {
         if (this != &other)
         {
-            clear();
+            release();
 
-            swap(other);
+            take(other);
         }
 
         return *this;
     }
 
-    template <typename T>
-    inline std::size_t data_buffer<T>::calculate_growth(std::size_t new_size) const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    MEM_STRONG_INLINE bool data_buffer<T, InlineCapacity, Alignment>::is_inline() const noexcept
+    {
+        return data_ == storage::inline_data();
+    }
+
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline std::size_t data_buffer<T, InlineCapacity, Alignment>::calculate_growth(
+        std::size_t new_size) const noexcept
     {
         std::size_t old_capacity = capacity();
 
@@ -169,6 +237,11 @@ namespace mem
                 new_capacity = new_size;
             }
 
+            if (new_capacity < min_capacity)
+            {
+                new_capacity = min_capacity;
+            }
+
             return new_capacity;
         }
         else
@@ -177,58 +250,129 @@ namespace mem
         }
     }
 
-    template <typename T>
-    inline void data_buffer<T>::reallocate(std::size_t length)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::reallocate(std::size_t length)
     {
-        if (length != capacity_)
+        if (length < InlineCapacity)
         {
-            void* new_data = nullptr;
+            length = InlineCapacity;
+        }
 
-            if (length)
-            {
-                new_data = std::realloc(data_, length * sizeof(T));
+        if (length == capacity_)
+        {
+            return;
+        }
 
-                if (new_data == nullptr)
-                {
-                    std::abort();
-                }
-            }
-            else
+        if (length > (SIZE_MAX / sizeof(T)))
+        {
+            std::abort();
+        }
+
+        if (size_ > length)
+        {
+            size_ = length;
+        }
+
+        T* new_data = nullptr;
+
+        if (length == InlineCapacity)
+        {
+            new_data = storage::inline_data();
+        }
+        else if (!over_aligned && !is_inline())
+        {
+            new_data = static_cast<T*>(std::realloc(data_, length * sizeof(T)));
+
+            if (new_data == nullptr)
             {
-                std::free(data_);
+                std::abort();
             }
 
-            data_ = static_cast<T*>(new_data);
+            data_ = new_data;
             capacity_ = length;
 
-            if (size_ > capacity_)
+            return;
+        }
+        else
+        {
+            new_data = static_cast<T*>(
+                over_aligned ? aligned_alloc(length * sizeof(T), Alignment) : std::malloc(length * sizeof(T)));
+
+            if (new_data == nullptr)
+            {
+                std::abort();
+            }
+        }
+
+        if (size_)
+        {
+            std::memcpy(new_data, data_, size_ * sizeof(T));
+        }
+
+        release();
+
+        data_ = new_data;
+        capacity_ = length;
+    }
+
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::release() noexcept
+    {
+        if (data_ && !is_inline())
+        {
+            if (over_aligned)
+            {
+                aligned_free(data_);
+            }
+            else
             {
-                size_ = capacity_;
+                std::free(data_);
             }
         }
+
+        data_ = storage::inline_data();
+        capacity_ = InlineCapacity;
     }
 
-    template <typename T>
-    inline void data_buffer<T>::swap(data_buffer<T>& other) noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::take(data_buffer& other) noexcept
     {
-        if (this != &other)
+        if (other.is_inline())
         {
-            T* temp_data = data_;
-            std::size_t temp_size = size_;
-            std::size_t temp_capacity = capacity_;
+            if (other.size_)
+            {
+                std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+            }
 
+            size_ = other.size_;
+        }
+        else
+        {
             data_ = other.data_;
             size_ = other.size_;
             capacity_ = other.capacity_;
 
-            other.data_ = temp_data;
-            other.size_ = temp_size;
-            other.capacity_ = temp_capacity;
+            other.data_ = other.storage::inline_data();
+            other.capacity_ = InlineCapacity;
+        }
+
+        other.size_ = 0;
+    }
+
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::swap(data_buffer& other) noexcept
+    {
+        if (this != &other)
+        {
+            data_buffer temp(std::move(other));
+
+            other = std::move(*this);
+            *this = std::move(temp);
         }
     }
 
-    template <typename T>
-    inline void data_buffer<T>::reserve(std::size_t length)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::reserve(std::size_t length)
     {
         if (length > capacity_)
         {
@@ -236,122 +380,171 @@ namespace mem
         }
     }
 
-    template <typename T>
-    inline void data_buffer<T>::resize(std::size_t length)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::resize(std::size_t length)
     {
-        reallocate(length);
+        std::size_t old_size = size_;
 
-        size_ = length;
+        resize_uninitialized(length);
+
+        if (length > old_size)
+        {
+            std::memset(data_ + old_size, 0, (length - old_size) * sizeof(T));
+        }
     }
 
-    template <typename T>
-    inline void data_buffer<T>::reset(std::size_t length)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::reset(std::size_t length)
     {
         clear();
 
         resize(length);
     }
 
-    template <typename T>
-    inline void data_buffer<T>::assign(const T* source, std::size_t length)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::resize_uninitialized(std::size_t length)
     {
-        clear();
+        reserve(calculate_growth(length));
 
-        append(source, length);
+        size_ = length;
     }
 
-    template <typename T>
-    inline void data_buffer<T>::append(const T* source, std::size_t length)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline T* data_buffer<T, InlineCapacity, Alignment>::append_uninitialized(std::size_t length)
     {
         std::size_t old_size = size_;
-        std::size_t new_size = old_size + length;
 
-        reserve(calculate_growth(new_size));
-        std::memcpy(data_ + old_size, source, length * sizeof(T));
+        resize_uninitialized(old_size + length);
 
-        size_ = new_size;
+        return data_ + old_size;
     }
 
-    template <typename T>
-    inline void data_buffer<T>::push_back(const T& value)
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::assign(const T* source, std::size_t length)
     {
-        append(&value, 1);
+        // Nothing needs to be kept, so growing does not copy the old values
+        clear();
+
+        if (length)
+        {
+            reserve(length);
+            std::memcpy(data_, source, length * sizeof(T));
+        }
+
+        size_ = length;
     }
 
-    template <typename T>
-    inline void data_buffer<T>::clear() noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::append(const T* source, std::size_t length)
+    {
+        if (!length)
+        {
+            return;
+        }
+
+        // The source may be part of this buffer, which can move while growing
+        if ((source >= data_) && (source < data_ + size_))
+        {
+            std::size_t offset = static_cast<std::size_t>(source - data_);
+            T* dest = append_uninitialized(length);
+
+            std::memcpy(dest, data_ + offset, length * sizeof(T));
+        }
+        else
+        {
+            std::memcpy(append_uninitialized(length), source, length * sizeof(T));
+        }
+    }
+
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::push_back(const T& value)
+    {
+        T copy = value;
+
+        *append_uninitialized(1) = copy;
+    }
+
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::clear() noexcept
     {
         size_ = 0;
     }
 
-    template <typename T>
-    inline void data_buffer<T>::shrink_to_fit()
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline void data_buffer<T, InlineCapacity, Alignment>::shrink_to_fit()
     {
-        resize(size_);
+        if (!size_)
+        {
+            release();
+        }
+        else
+        {
+            reallocate(size_);
+        }
     }
 
-    template <typename T>
-    inline T& data_buffer<T>::operator[](std::size_t index) noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline T& data_buffer<T, InlineCapacity, Alignment>::operator[](std::size_t index) noexcept
     {
         return data_[index];
     }
 
-    template <typename T>
-    inline const T& data_buffer<T>::operator[](std::size_t index) const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline const T& data_buffer<T, InlineCapacity, Alignment>::operator[](std::size_t index) const noexcept
     {
         return data_[index];
     }
 
-    template <typename T>
-    inline T* data_buffer<T>::data() noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline T* data_buffer<T, InlineCapacity, Alignment>::data() noexcept
     {
         return data_;
     }
 
-    template <typename T>
-    inline T* data_buffer<T>::begin() noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline T* data_buffer<T, InlineCapacity, Alignment>::begin() noexcept
     {
         return data_;
     }
 
-    template <typename T>
-    inline T* data_buffer<T>::end() noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline T* data_buffer<T, InlineCapacity, Alignment>::end() noexcept
     {
         return data_ + size_;
     }
 
-    template <typename T>
-    inline const T* data_buffer<T>::data() const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline const T* data_buffer<T, InlineCapacity, Alignment>::data() const noexcept
     {
         return data_;
     }
 
-    template <typename T>
-    inline const T* data_buffer<T>::begin() const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline const T* data_buffer<T, InlineCapacity, Alignment>::begin() const noexcept
     {
         return data_;
     }
 
-    template <typename T>
-    inline const T* data_buffer<T>::end() const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline const T* data_buffer<T, InlineCapacity, Alignment>::end() const noexcept
     {
         return data_ + size_;
     }
 
-    template <typename T>
-    inline std::size_t data_buffer<T>::size() const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline std::size_t data_buffer<T, InlineCapacity, Alignment>::size() const noexcept
     {
         return size_;
     }
 
-    template <typename T>
-    inline std::size_t data_buffer<T>::capacity() const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline std::size_t data_buffer<T, InlineCapacity, Alignment>::capacity() const noexcept
     {
         return capacity_;
     }
 
-    template <typename T>
-    inline bool data_buffer<T>::empty() const noexcept
+    template <typename T, std::size_t InlineCapacity, std::size_t Alignment>
+    inline bool data_buffer<T, InlineCapacity, Alignment>::empty() const noexcept
     {
         return size_ == 0;
     }
@@ -0,0 +1,389 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_FAULT_GUARD_BRICK_H
+#define MEM_FAULT_GUARD_BRICK_H
+
+#include <mem/memory/protect.h>
+#include <mem/memory/region.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#if defined(_WIN32)
+#    if !defined(_MSC_VER)
+#        error fault_guard needs structured exception handling
+#    endif
+#    if !defined(WIN32_LEAN_AND_MEAN)
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <Windows.h>
+#elif defined(__unix__)
+#    include <setjmp.h>
+#    include <signal.h>
+#else
+#    error Unknown Platform
+#endif
+
+namespace mem
+{
+    // Runs code which may fault, returning false instead of crashing when it does.
+    //
+    // Unlike execution_handler, nothing is installed or removed per use. The signal handlers are installed once
+    // for the whole process, and each thread gets an alternate signal stack the first time it enters a guard.
+    // After that, a guard costs a sigsetjmp, without saving the signal mask, and a thread local write.
+    //
+    // Faults outside of a guard are passed on to whichever handlers were installed before. Handlers installed
+    // later take precedence, and must pass faults on for guards to keep working.
+    //
+    // Jumping out of a fault skips any destructors in the faulting code, so guarded code should only read.
+    class fault_guard
+    {
+    public:
+        // Installs the handlers if they are not already. Entering a guard does this as well.
+        static void install();
+
+        // Calls func, and returns false if it faulted
+        template <typename Func>
+        static bool execute(Func&& func);
+
+        // The address of the last fault caught on this thread
+        static void* fault_address() noexcept;
+    };
+
+    // Copies size bytes from address into buffer, returning false if any of them could not be read
+    bool safe_read(const void* address, void* buffer, std::size_t size);
+
+    // Calls func with each result of scanner in range, skipping any pages which cannot be read, until func
+    // returns true. Results are reported outside of the guard, so func may do anything.
+    template <typename Scanner, typename Func>
+    pointer safe_scan(const Scanner& scanner, region range, Func func);
+
+    namespace internal
+    {
+        struct fault_state
+        {
+#if defined(__unix__)
+            sigjmp_buf* jump;
+            bool ready;
+#endif
+            void* address;
+        };
+
+        // Trivial, so reading it from a signal handler never runs an initializer
+        inline fault_state& fault_thread_state() noexcept
+        {
+            static thread_local fault_state state {};
+
+            return state;
+        }
+
+#if defined(__unix__)
+        static constexpr const int fault_signals[] {SIGSEGV, SIGBUS, SIGILL, SIGFPE};
+
+        inline struct sigaction* fault_previous_actions() noexcept
+        {
+            static struct sigaction actions[sizeof(fault_signals) / sizeof(*fault_signals)] {};
+
+            return actions;
+        }
+
+        inline void fault_handler(int sig, siginfo_t* info, void* context)
+        {
+            fault_state& state = fault_thread_state();
+
+            if (sigjmp_buf* jump = state.jump)
+            {
+                state.jump = nullptr;
+                state.address = info->si_addr;
+
+                siglongjmp(*jump, 1);
+            }
+
+            std::size_t index = 0;
+
+            while (fault_signals[index] != sig)
+                ++index;
+
+            const struct sigaction& previous = fault_previous_actions()[index];
+
+            if (previous.sa_flags & SA_SIGINFO)
+            {
+                if (previous.sa_sigaction)
+                    previous.sa_sigaction(sig, info, context);
+
+                return;
+            }
+
+            if ((previous.sa_handler != SIG_DFL) && (previous.sa_handler != SIG_IGN))
+            {
+                previous.sa_handler(sig);
+
+                return;
+            }
+
+            // Put the default action back. A fault then happens again on return, and a sent signal is raised again.
+            struct sigaction action {};
+            action.sa_handler = SIG_DFL;
+            sigemptyset(&action.sa_mask);
+            sigaction(sig, &action, nullptr);
+
+            if (info->si_code <= 0)
+                raise(sig);
+        }
+
+        inline bool install_fault_handlers()
+        {
+            struct sigaction action {};
+
+            action.sa_sigaction = &fault_handler;
+            // No SA_NODEFER would leave the signal blocked after jumping out, as sigsetjmp does not save the mask
+            action.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_NODEFER;
+            sigemptyset(&action.sa_mask);
+
+            bool success = true;
+
+            for (std::size_t i = 0; i < sizeof(fault_signals) / sizeof(*fault_signals); ++i)
+                success &= !sigaction(fault_signals[i], &action, &fault_previous_actions()[i]);
+
+            return success;
+        }
+
+        // The alternate signal stack of a thread, which is removed when the thread exits
+        class fault_stack
+        {
+        private:
+            std::unique_ptr<char[]> stack_ {};
+
+        public:
+            fault_stack();
+            ~fault_stack();
+
+            fault_stack(const fault_stack&) = delete;
+            fault_stack& operator=(const fault_stack&) = delete;
+        };
+
+        inline fault_stack::fault_stack()
+        {
+            stack_t current {};
+
+            // Keep a stack someone else already gave this thread
+            if (!sigaltstack(nullptr, &current) && !(current.ss_flags & SS_DISABLE))
+                return;
+
+            const std::size_t size =
+                (SIGSTKSZ > 0x10000) ? static_cast<std::size_t>(SIGSTKSZ) : static_cast<std::size_t>(0x10000);
+
+            stack_.reset(new char[size]);
+
+            stack_t value {};
+            value.ss_sp = stack_.get();
+            value.ss_size = size;
+            value.ss_flags = 0;
+
+            if (sigaltstack(&value, nullptr))
+                stack_.reset();
+        }
+
+        inline fault_stack::~fault_stack()
+        {
+            if (!stack_)
+                return;
+
+            stack_t current {};
+
+            if (!sigaltstack(nullptr, &current) && (current.ss_sp == stack_.get()))
+            {
+                stack_t value {};
+                value.ss_flags = SS_DISABLE;
+
+                sigaltstack(&value, nullptr);
+            }
+        }
+
+        MEM_NOINLINE inline void prepare_fault_thread()
+        {
+            fault_guard::install();
+
+            static thread_local fault_stack stack;
+
+            fault_thread_state().ready = true;
+        }
+#elif defined(_WIN32)
+        inline int fault_filter(EXCEPTION_POINTERS* info) noexcept
+        {
+            const EXCEPTION_RECORD* record = info->ExceptionRecord;
+
+            switch (record->ExceptionCode)
+            {
+                case EXCEPTION_ACCESS_VIOLATION:
+                case EXCEPTION_IN_PAGE_ERROR:
+                    fault_thread_state().address = reinterpret_cast<void*>(record->ExceptionInformation[1]);
+                    return EXCEPTION_EXECUTE_HANDLER;
+
+                case EXCEPTION_ILLEGAL_INSTRUCTION:
+                case EXCEPTION_INT_DIVIDE_BY_ZERO:
+                    fault_thread_state().address = record->ExceptionAddress;
+                    return EXCEPTION_EXECUTE_HANDLER;
+            }
+
+            return EXCEPTION_CONTINUE_SEARCH;
+        }
+#endif
+    } // namespace internal
+
+#if defined(__unix__)
+    inline void fault_guard::install()
+    {
+        static const bool installed = internal::install_fault_handlers();
+
+        static_cast<void>(installed);
+    }
+
+    template <typename Func>
+    inline bool fault_guard::execute(Func&& func)
+    {
+        internal::fault_state& state = internal::fault_thread_state();
+
+        if (MEM_UNLIKELY(!state.ready))
+            internal::prepare_fault_thread();
+
+        sigjmp_buf* const previous = state.jump;
+        sigjmp_buf jump;
+
+        if (sigsetjmp(jump, 0))
+        {
+            state.jump = previous;
+
+            return false;
+        }
+
+        state.jump = &jump;
+
+        try
+        {
+            func();
+        }
+        catch (...)
+        {
+            state.jump = previous;
+
+            throw;
+        }
+
+        state.jump = previous;
+
+        return true;
+    }
+#elif defined(_WIN32)
+    inline void fault_guard::install()
+    {}
+
+    template <typename Func>
+    inline bool fault_guard::execute(Func&& func)
+    {
+        __try
+        {
+            func();
+        }
+        __except (internal::fault_filter(GetExceptionInformation()))
+        {
+            return false;
+        }
+
+        return true;
+    }
+#endif
+
+    MEM_STRONG_INLINE void* fault_guard::fault_address() noexcept
+    {
+        return internal::fault_thread_state().address;
+    }
+
+    inline bool safe_read(const void* address, void* buffer, std::size_t size)
+    {
+        return fault_guard::execute([=] { std::memcpy(buffer, address, size); });
+    }
+
+    template <typename Scanner, typename Func>
+    inline pointer safe_scan(const Scanner& scanner, region range, Func func)
+    {
+        const std::uintptr_t page = page_size();
+
+        const std::uintptr_t end = range.start.as<std::uintptr_t>() + range.size;
+
+        std::uintptr_t current = range.start.as<std::uintptr_t>();
+        std::uintptr_t limit = end; // Short of end while rescanning the pages before a fault
+        std::uintptr_t skip = end;  // Where to carry on once the rescan is done
+
+        while (current < end)
+        {
+            pointer result = nullptr;
+
+            const region part(current, limit - current, range.flags);
+
+            if (fault_guard::execute([&] { result = scanner.scan(part); }))
+            {
+                if (result)
+                {
+                    if (func(result))
+                        return result;
+
+                    current = result.as<std::uintptr_t>() + 1;
+                }
+                else if (limit != end)
+                {
+                    current = skip;
+                    limit = end;
+                }
+                else
+                {
+                    break;
+                }
+
+                continue;
+            }
+
+            const std::uintptr_t fault = reinterpret_cast<std::uintptr_t>(fault_guard::fault_address());
+
+            // Not a read of the range, so skipping ahead would not help
+            if ((fault < current) || (fault >= limit))
+                break;
+
+            const std::uintptr_t fault_page = fault & ~(page - 1);
+
+            if (fault_page > current)
+            {
+                // The scanner may have read ahead into the page, so scan up to it on its own first
+                limit = fault_page;
+                skip = fault_page + page;
+            }
+            else
+            {
+                current = fault_page + page;
+                limit = end;
+            }
+        }
+
+        return nullptr;
+    }
+} // namespace mem
+
+#endif // MEM_FAULT_GUARD_BRICK_H
@@ -14,5 +14,12 @@ namespace mem
         prot_flags flags;
     };
 
+    // How an executable image is laid out in memory
+    enum class image_layout
+    {
+        mapped, // Loaded by the OS loader, sections at their virtual addresses
+        file,   // Raw file contents, sections at their file offsets
+    };
+
 } // namespace mem
 #endif
\ No newline at end of file
@@ -0,0 +1,491 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_ITANIUM_RTTI_BRICK_H
+#define MEM_ITANIUM_RTTI_BRICK_H
+
+#include <mem/memory/mem.h>
+#include <mem/memory/module.h>
+#include <mem/memory/region_set.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#if defined(MEM_RTTI_DEMANGLE)
+#    include <cstdlib>
+#    include <cxxabi.h>
+#endif // MEM_RTTI_DEMANGLE
+
+#if defined(MEM_SIMD_AVX2)
+#    include <immintrin.h>
+#elif defined(MEM_SIMD_SSE2)
+#    include <emmintrin.h>
+#endif
+
+namespace mem
+{
+    namespace rtti
+    {
+        enum class itanium_kind
+        {
+            class_type,     // __class_type_info, no bases
+            si_class_type,  // __si_class_type_info, one public non-virtual base at offset 0
+            vmi_class_type, // __vmi_class_type_info, anything else
+        };
+
+        struct itanium_type
+        {
+            // The std::type_info object
+            const void* type_info {nullptr};
+
+            // Mangled name, without the _ZTS prefix or the leading '*' of internal types
+            const char* name {nullptr};
+
+            itanium_kind kind {itanium_kind::class_type};
+
+            // type_info objects of the direct bases, which may live in other modules
+            std::vector<const void*> bases {};
+
+            // Address points (the vptr values) of every vtable referring to this type, sorted by address
+            std::vector<pointer> vtables {};
+
+            // The address point with an offset-to-top of 0, or nullptr
+            pointer vtable() const noexcept;
+
+#if defined(MEM_RTTI_DEMANGLE)
+            std::string demangle() const;
+#endif // MEM_RTTI_DEMANGLE
+        };
+
+        // Class types and vtables of a loaded module, indexed by mangled name and by type_info address.
+        // Built with one pass over the non-executable segments to find type_info objects, and one to find vtables.
+        // Only type_info objects named inside the module are indexed, so copies made by copy relocations are skipped.
+        class itanium_index
+        {
+        private:
+            std::vector<itanium_type> types_ {};
+
+            std::unordered_map<std::string, std::size_t> by_name_ {};
+            std::unordered_map<const void*, std::size_t> by_address_ {};
+
+            // words is how many pointer sized words of the segment start at object.
+            // readable holds every readable segment of image, sorted by address.
+            void add_type(const region& image, const std::vector<region>& readable, const void* const* object,
+                std::size_t words, itanium_kind kind, region_set& spans);
+            void add_vtables(const region& range, const region_set& spans);
+
+        public:
+            using iterator = std::vector<itanium_type>::const_iterator;
+
+            itanium_index() = default;
+
+            explicit itanium_index(module image);
+
+            const itanium_type* find(const char* name) const;
+            const itanium_type* find(const std::type_info& type) const;
+            const itanium_type* find_type_info(const void* type_info) const;
+
+            std::size_t size() const noexcept;
+            bool empty() const noexcept;
+
+            iterator begin() const noexcept;
+            iterator end() const noexcept;
+        };
+
+        namespace internal
+        {
+            struct itanium_base_a
+            {};
+
+            struct itanium_base_b
+            {};
+
+            struct itanium_single : itanium_base_a
+            {};
+
+            struct itanium_multiple : itanium_base_a, itanium_base_b
+            {};
+
+            // The vtables of the __cxxabiv1 type_info classes, as found in the vptr of every class type_info
+            inline const void* type_info_vptr(const std::type_info& type) noexcept
+            {
+                return *reinterpret_cast<const void* const*>(&type);
+            }
+
+            // Calls func(index) for each word equal to one of values, in increasing order
+            template <typename Func>
+            inline void find_words(const std::uintptr_t* words, std::size_t count, const std::uintptr_t (&values)[3],
+                Func func)
+            {
+                std::size_t i = 0;
+
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+#    if defined(MEM_SIMD_AVX2)
+                using vector = __m256i;
+
+                const auto load = [](const std::uintptr_t* ptr) {
+                    return _mm256_loadu_si256(reinterpret_cast<const vector*>(ptr));
+                };
+                const auto either = [](vector lhs, vector rhs) { return _mm256_or_si256(lhs, rhs); };
+                const auto mask = [](vector value) { return _mm256_movemask_epi8(value); };
+
+#        if defined(MEM_ARCH_X86_64)
+                const auto fill = [](std::uintptr_t value) {
+                    return _mm256_set1_epi64x(static_cast<long long>(value));
+                };
+                const auto equal = [](vector lhs, vector rhs) { return _mm256_cmpeq_epi64(lhs, rhs); };
+#        else
+                const auto fill = [](std::uintptr_t value) { return _mm256_set1_epi32(static_cast<int>(value)); };
+                const auto equal = [](vector lhs, vector rhs) { return _mm256_cmpeq_epi32(lhs, rhs); };
+#        endif
+#    else
+                using vector = __m128i;
+
+                const auto load = [](const std::uintptr_t* ptr) {
+                    return _mm_loadu_si128(reinterpret_cast<const vector*>(ptr));
+                };
+                const auto either = [](vector lhs, vector rhs) { return _mm_or_si128(lhs, rhs); };
+                const auto mask = [](vector value) { return _mm_movemask_epi8(value); };
+
+#        if defined(MEM_ARCH_X86_64)
+                const auto fill = [](std::uintptr_t value) {
+                    return _mm_set1_epi64x(static_cast<long long>(value));
+                };
+
+                // SSE2 has no 64-bit compare, so both halves of a lane must match
+                const auto equal = [](vector lhs, vector rhs) {
+                    const vector halves = _mm_cmpeq_epi32(lhs, rhs);
+                    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+                };
+#        else
+                const auto fill = [](std::uintptr_t value) { return _mm_set1_epi32(static_cast<int>(value)); };
+                const auto equal = [](vector lhs, vector rhs) { return _mm_cmpeq_epi32(lhs, rhs); };
+#        endif
+#    endif
+
+                constexpr std::size_t lanes = sizeof(vector) / sizeof(std::uintptr_t);
+
+                const vector value0 = fill(values[0]);
+                const vector value1 = fill(values[1]);
+                const vector value2 = fill(values[2]);
+
+                for (; i + lanes * 2 <= count; i += lanes * 2)
+                {
+                    const vector lo = load(words + i);
+                    const vector hi = load(words + i + lanes);
+
+                    const vector hits = either(either(either(equal(lo, value0), equal(lo, value1)),
+                                                   either(equal(lo, value2), equal(hi, value0))),
+                        either(equal(hi, value1), equal(hi, value2)));
+
+                    if (MEM_LIKELY(!mask(hits)))
+                        continue;
+
+                    for (std::size_t j = i; j < i + lanes * 2; ++j)
+                    {
+                        if ((words[j] == values[0]) || (words[j] == values[1]) || (words[j] == values[2]))
+                            func(j);
+                    }
+                }
+#endif
+
+                for (; i < count; ++i)
+                {
+                    if ((words[i] == values[0]) || (words[i] == values[1]) || (words[i] == values[2]))
+                        func(i);
+                }
+            }
+
+            // Accepts the characters of mangled type names, up to the NUL which must be inside the same segment.
+            // The gaps between segments may not be mapped, so a name outside of them is never read.
+            inline const char* check_type_name(const std::vector<region>& readable, const char* name) noexcept
+            {
+                const auto after = std::upper_bound(readable.begin(), readable.end(), pointer(name),
+                    [](pointer address, const region& range) { return address < range.start; });
+
+                if ((after == readable.begin()) || !(after - 1)->contains(name))
+                    return nullptr;
+
+                const char* const end = (after - 1)->start.add((after - 1)->size).as<const char*>();
+
+                if (*name == '*')
+                    ++name;
+
+                const char first = *name;
+
+                if (!((first >= '0' && first <= '9') || first == 'N' || first == 'S' || first == 'Z'))
+                    return nullptr;
+
+                for (const char* current = name; current != end; ++current)
+                {
+                    const char c = *current;
+
+                    if (!c)
+                        return name;
+
+                    if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+                            c == '$' || c == '.'))
+                        return nullptr;
+                }
+
+                return nullptr;
+            }
+        } // namespace internal
+
+        inline pointer itanium_type::vtable() const noexcept
+        {
+            for (pointer address : vtables)
+            {
+                if ((address - sizeof(void*) * 2).at<const std::ptrdiff_t>(0) == 0)
+                    return address;
+            }
+
+            return nullptr;
+        }
+
+#if defined(MEM_RTTI_DEMANGLE)
+        inline std::string itanium_type::demangle() const
+        {
+            int status = 0;
+
+            char* buffer = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+            if (!buffer)
+                return "";
+
+            std::string result(buffer);
+            std::free(buffer);
+
+            return result;
+        }
+#endif // MEM_RTTI_DEMANGLE
+
+        inline void itanium_index::add_type(const region& image, const std::vector<region>& readable,
+            const void* const* object, std::size_t words, itanium_kind kind, region_set& spans)
+        {
+            // Nothing past the end of the segment is read, which may be the end of the mapping
+            const region segment(object, words * sizeof(void*));
+
+            const char* name = internal::check_type_name(readable, static_cast<const char*>(object[1]));
+
+            if (!name)
+                return;
+
+            itanium_type type;
+            type.type_info = object;
+            type.name = name;
+            type.kind = kind;
+
+            std::size_t size = sizeof(void*) * 2;
+
+            switch (kind)
+            {
+                case itanium_kind::si_class_type:
+                    if (words < 3)
+                        return;
+
+                    type.bases.push_back(object[2]);
+                    size += sizeof(void*);
+                    break;
+
+                case itanium_kind::vmi_class_type:
+                {
+                    // unsigned int flags, base_count, followed by pointer aligned {base_type, offset_flags} pairs
+                    const pointer counts = &object[2];
+
+                    if (!segment.contains(counts, sizeof(unsigned int) * 2))
+                        return;
+
+                    const unsigned int base_count = counts.at<const unsigned int>(sizeof(unsigned int));
+                    const pointer base_info = counts.add(sizeof(unsigned int) * 2).align_up(sizeof(void*));
+
+                    const std::size_t base_size = std::size_t(base_count) * sizeof(void*) * 2;
+
+                    if (!image.contains(base_info, base_size) || !segment.contains(base_info, base_size))
+                        return;
+
+                    for (unsigned int i = 0; i < base_count; ++i)
+                        type.bases.push_back(base_info.at<const void* const>(i * sizeof(void*) * 2));
+
+                    size = static_cast<std::size_t>(base_info - pointer(object)) + base_size;
+                    break;
+                }
+
+                case itanium_kind::class_type: break;
+            }
+
+            if (!by_address_.emplace(object, types_.size()).second)
+                return;
+
+            by_name_.emplace(name, types_.size());
+            spans.insert(region(object, size));
+            types_.push_back(std::move(type));
+        }
+
+        inline void itanium_index::add_vtables(const region& range, const region_set& spans)
+        {
+            if (spans.empty())
+                return;
+
+            const region& last = *(spans.end() - 1);
+
+            const std::uintptr_t lowest = spans.begin()->start.as<std::uintptr_t>();
+            const std::uintptr_t extent = last.start.as<std::uintptr_t>() + last.size - lowest;
+
+            const std::uintptr_t* words = range.start.as<const std::uintptr_t*>();
+            const std::size_t count = range.size / sizeof(std::uintptr_t);
+
+            // Each vtable group is {offset_to_top, type_info, virtual functions...}
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                if (MEM_LIKELY(words[i] - lowest >= extent))
+                    continue;
+
+                const auto iter = by_address_.find(reinterpret_cast<const void*>(words[i]));
+
+                if (iter == by_address_.end())
+                    continue;
+
+                const std::intptr_t offset_to_top = static_cast<std::intptr_t>(words[i - 1]);
+
+                if ((offset_to_top > 0) || (offset_to_top < -0x10000000))
+                    continue;
+
+                // Base class pointers inside the type_info objects themselves
+                if (spans.contains(pointer(&words[i])))
+                    continue;
+
+                types_[iter->second].vtables.push_back(&words[i + 1]);
+            }
+        }
+
+        inline itanium_index::itanium_index(module image)
+        {
+            if (!image.size)
+                return;
+
+            const std::uintptr_t vptrs[3] {
+                reinterpret_cast<std::uintptr_t>(internal::type_info_vptr(typeid(internal::itanium_base_a))),
+                reinterpret_cast<std::uintptr_t>(internal::type_info_vptr(typeid(internal::itanium_single))),
+                reinterpret_cast<std::uintptr_t>(internal::type_info_vptr(typeid(internal::itanium_multiple))),
+            };
+
+            std::vector<region> segments;
+            std::vector<region> readable;
+
+            image.enum_segments([&segments, &readable](region range, prot_flags prot) {
+                if (prot & prot_flags::R)
+                    readable.push_back(range);
+
+                if ((prot & prot_flags::R) && !(prot & prot_flags::X))
+                {
+                    const pointer start = range.start.align_up(sizeof(void*));
+                    const pointer end = range.start.add(range.size).align_down(sizeof(void*));
+
+                    if (start < end)
+                        segments.emplace_back(start, static_cast<std::size_t>(end - start));
+                }
+
+                return false;
+            });
+
+            // Type names may also be in an executable segment, with older linkers
+            std::sort(readable.begin(), readable.end(),
+                [](const region& lhs, const region& rhs) { return lhs.start < rhs.start; });
+
+            region_set spans;
+
+            for (const region& range : segments)
+            {
+                const std::uintptr_t* words = range.start.as<const std::uintptr_t*>();
+                const std::size_t count = range.size / sizeof(std::uintptr_t);
+
+                internal::find_words(words, count, vptrs, [&](std::size_t i) {
+                    // A type_info is at least a vptr and a name
+                    if (i + 2 > count)
+                        return;
+
+                    const itanium_kind kind = (words[i] == vptrs[0])
+                        ? itanium_kind::class_type
+                        : (words[i] == vptrs[1]) ? itanium_kind::si_class_type : itanium_kind::vmi_class_type;
+
+                    add_type(image, readable, reinterpret_cast<const void* const*>(&words[i]), count - i, kind, spans);
+                });
+            }
+
+            if (types_.empty())
+                return;
+
+            for (const region& range : segments)
+                add_vtables(range, spans);
+
+            for (itanium_type& type : types_)
+                std::sort(type.vtables.begin(), type.vtables.end());
+        }
+
+        inline const itanium_type* itanium_index::find(const char* name) const
+        {
+            if (*name == '*')
+                ++name;
+
+            const auto iter = by_name_.find(name);
+
+            return (iter != by_name_.end()) ? &types_[iter->second] : nullptr;
+        }
+
+        MEM_STRONG_INLINE const itanium_type* itanium_index::find(const std::type_info& type) const
+        {
+            return find_type_info(&type);
+        }
+
+        inline const itanium_type* itanium_index::find_type_info(const void* type_info) const
+        {
+            const auto iter = by_address_.find(type_info);
+
+            return (iter != by_address_.end()) ? &types_[iter->second] : nullptr;
+        }
+
+        MEM_STRONG_INLINE std::size_t itanium_index::size() const noexcept
+        {
+            return types_.size();
+        }
+
+        MEM_STRONG_INLINE bool itanium_index::empty() const noexcept
+        {
+            return types_.empty();
+        }
+
+        MEM_STRONG_INLINE itanium_index::iterator itanium_index::begin() const noexcept
+        {
+            return types_.begin();
+        }
+
+        MEM_STRONG_INLINE itanium_index::iterator itanium_index::end() const noexcept
+        {
+            return types_.end();
+        }
+    } // namespace rtti
+} // namespace mem
+
+#endif // MEM_ITANIUM_RTTI_BRICK_H
@@ -21,12 +21,17 @@
 #define MEM_MODULE_BRICK_H
 
 #include <mem/memory/mem.h>
+#include <mem/memory/region.h>
 #include <mem/memory/prot_flags.h>
 #include <mem/containers/slice.h>
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #if defined(_WIN32)
 #    if !defined(WIN32_LEAN_AND_MEAN)
@@ -84,6 +89,16 @@ namespace mem
 #if defined(_WIN32)
         template <typename Func>
         void enum_exports(Func func);
+
+        pointer find_export(const char* name);
+#elif defined(__unix__)
+        // Both parse the headers on every call. Use elf_exports for more than one lookup in the same image.
+        template <typename Func>
+        void enum_exports(
+            Func func, image_layout layout = image_layout::mapped, const data_accessor* accessor = nullptr);
+
+        pointer find_export(
+            const char* name, image_layout layout = image_layout::mapped, const data_accessor* accessor = nullptr);
 #endif
     };
 
@@ -227,6 +242,23 @@ namespace mem
         }
     }
 
+    inline pointer module::find_export(const char* name)
+    {
+        pointer result = nullptr;
+
+        enum_exports([name, &result](const char* export_name, uint16_t, pointer function) {
+            if (export_name && !std::strcmp(export_name, name))
+            {
+                result = function;
+                return true;
+            }
+
+            return false;
+        });
+
+        return result;
+    }
+
 #elif defined(__unix__)
     // https://github.com/torvalds/linux/blob/master/fs/binfmt_elf.c
     inline std::size_t total_mapping_size(const ElfW(Phdr) * cmds, std::size_t count)
@@ -326,6 +358,527 @@ namespace mem
         }
     }
 
+    namespace internal
+    {
+        // Reads the dynamic symbol tables of an ELF image, locally or through an accessor
+        class elf_image
+        {
+        private:
+            std::uintptr_t base_ {0};
+            std::size_t size_ {0};
+            image_layout layout_ {image_layout::mapped};
+            const data_accessor* accessor_ {nullptr};
+
+            // Virtual address of file offset 0
+            std::uintptr_t image_vaddr_ {0};
+
+            std::vector<ElfW(Phdr)> loads_ {};
+
+            ElfW(Addr) gnu_hash_ {0};
+            ElfW(Addr) hash_ {0};
+            ElfW(Addr) symtab_ {0};
+            ElfW(Addr) strtab_ {0};
+            ElfW(Addr) versym_ {0};
+            std::size_t strsz_ {0};
+
+            bool read_raw(std::uintptr_t address, void* data, std::size_t size) const;
+
+            template <typename T>
+            bool read(ElfW(Addr) vaddr, T& value) const;
+
+            ElfW(Addr) from_dyn_ptr(ElfW(Addr) value) const noexcept;
+
+            bool name_equals(ElfW(Word) offset, const char* name, std::size_t length) const;
+
+            static std::uint32_t gnu_hash(const char* name) noexcept;
+            static std::uint32_t sysv_hash(const char* name) noexcept;
+
+        public:
+            elf_image(region image, image_layout layout, const data_accessor* accessor);
+
+            bool has_symbols() const noexcept;
+
+            std::uintptr_t address_of(ElfW(Addr) vaddr) const;
+
+            std::size_t symbol_count() const;
+
+            bool symbol(std::size_t index, ElfW(Sym)& sym) const;
+
+            bool symbol_name(const ElfW(Sym) & sym, std::string& name) const;
+            const char* local_symbol_name(const ElfW(Sym) & sym) const;
+
+            bool is_export(const ElfW(Sym) & sym) const noexcept;
+
+            // Whether the symbol is the default version of its name, as picked by dlsym
+            bool is_default_version(std::size_t index) const;
+
+            std::size_t find_symbol(const char* name) const;
+        };
+
+        MEM_STRONG_INLINE bool elf_image::read_raw(std::uintptr_t address, void* data, std::size_t size) const
+        {
+            if ((address < base_) || (size > size_) || (address - base_ > size_ - size))
+                return false;
+
+            if (accessor_)
+                return accessor_->read(reinterpret_cast<void*>(address), data, size);
+
+            std::memcpy(data, reinterpret_cast<const void*>(address), size);
+
+            return true;
+        }
+
+        template <typename T>
+        MEM_STRONG_INLINE bool elf_image::read(ElfW(Addr) vaddr, T& value) const
+        {
+            const std::uintptr_t address = address_of(vaddr);
+
+            return address && read_raw(address, &value, sizeof(value));
+        }
+
+        inline elf_image::elf_image(region image, image_layout layout, const data_accessor* accessor)
+            : base_(image.start.as<std::uintptr_t>())
+            , size_(image.size)
+            , layout_(layout)
+            , accessor_(accessor)
+        {
+            ElfW(Ehdr) ehdr;
+
+            // clang-format off
+            if (!read_raw(base_, &ehdr, sizeof(ehdr)) ||
+                ehdr.e_ident[EI_MAG0] != ELFMAG0 ||
+                ehdr.e_ident[EI_MAG1] != ELFMAG1 ||
+                ehdr.e_ident[EI_MAG2] != ELFMAG2 ||
+                ehdr.e_ident[EI_MAG3] != ELFMAG3 ||
+                ehdr.e_phentsize != sizeof(ElfW(Phdr)))
+                return;
+            // clang-format on
+
+            std::vector<ElfW(Phdr)> phdrs(ehdr.e_phnum);
+
+            if (!read_raw(base_ + ehdr.e_phoff, phdrs.data(), phdrs.size() * sizeof(ElfW(Phdr))))
+                return;
+
+            const ElfW(Phdr)* dynamic = nullptr;
+
+            for (const ElfW(Phdr) & phdr : phdrs)
+            {
+                if (phdr.p_type == PT_LOAD)
+                {
+                    if (loads_.empty())
+                        image_vaddr_ = phdr.p_vaddr - phdr.p_offset;
+
+                    loads_.push_back(phdr);
+                }
+                else if (phdr.p_type == PT_DYNAMIC)
+                {
+                    dynamic = &phdr;
+                }
+            }
+
+            if (!dynamic || loads_.empty())
+                return;
+
+            for (ElfW(Addr) vaddr = dynamic->p_vaddr, end = vaddr + dynamic->p_memsz; vaddr < end;
+                 vaddr += sizeof(ElfW(Dyn)))
+            {
+                ElfW(Dyn) dyn;
+
+                if (!read(vaddr, dyn) || (dyn.d_tag == DT_NULL))
+                    break;
+
+                switch (dyn.d_tag)
+                {
+                    case DT_GNU_HASH: gnu_hash_ = from_dyn_ptr(dyn.d_un.d_ptr); break;
+                    case DT_HASH: hash_ = from_dyn_ptr(dyn.d_un.d_ptr); break;
+                    case DT_SYMTAB: symtab_ = from_dyn_ptr(dyn.d_un.d_ptr); break;
+                    case DT_STRTAB: strtab_ = from_dyn_ptr(dyn.d_un.d_ptr); break;
+                    case DT_VERSYM: versym_ = from_dyn_ptr(dyn.d_un.d_ptr); break;
+                    case DT_STRSZ: strsz_ = dyn.d_un.d_val; break;
+                    default: break;
+                }
+            }
+        }
+
+        MEM_STRONG_INLINE ElfW(Addr) elf_image::from_dyn_ptr(ElfW(Addr) value) const noexcept
+        {
+            // The dynamic loader may have relocated the pointer in place (glibc does, musl does not)
+            if (layout_ == image_layout::mapped)
+            {
+                const std::uintptr_t bias = base_ - image_vaddr_;
+
+                if (bias && (value >= base_) && (value - base_ < size_))
+                    return value - bias;
+            }
+
+            return value;
+        }
+
+        inline std::uintptr_t elf_image::address_of(ElfW(Addr) vaddr) const
+        {
+            if (layout_ == image_layout::mapped)
+                return base_ + (vaddr - image_vaddr_);
+
+            for (const ElfW(Phdr) & load : loads_)
+            {
+                if ((vaddr >= load.p_vaddr) && (vaddr - load.p_vaddr < load.p_filesz))
+                    return base_ + load.p_offset + (vaddr - load.p_vaddr);
+            }
+
+            return 0;
+        }
+
+        MEM_STRONG_INLINE bool elf_image::has_symbols() const noexcept
+        {
+            return symtab_ && strtab_ && (gnu_hash_ || hash_);
+        }
+
+        MEM_STRONG_INLINE bool elf_image::symbol(std::size_t index, ElfW(Sym) & sym) const
+        {
+            return read(symtab_ + index * sizeof(ElfW(Sym)), sym);
+        }
+
+        MEM_STRONG_INLINE bool elf_image::is_export(const ElfW(Sym) & sym) const noexcept
+        {
+            const unsigned char bind = ELF32_ST_BIND(sym.st_info);
+
+            // Version definitions show up as absolute symbols at 0
+            return (sym.st_shndx != SHN_UNDEF) && (sym.st_name != 0) &&
+                ((sym.st_shndx != SHN_ABS) || (sym.st_value != 0)) &&
+                ((bind == STB_GLOBAL) || (bind == STB_WEAK) || (bind == STB_GNU_UNIQUE));
+        }
+
+        MEM_STRONG_INLINE bool elf_image::is_default_version(std::size_t index) const
+        {
+            ElfW(Half) version = 0;
+
+            return !versym_ || !read(versym_ + index * sizeof(ElfW(Half)), version) || !(version & 0x8000);
+        }
+
+        inline std::size_t elf_image::symbol_count() const
+        {
+            if (hash_)
+            {
+                std::uint32_t nchain = 0;
+
+                return read(hash_ + sizeof(std::uint32_t), nchain) ? nchain : 0;
+            }
+
+            // DT_GNU_HASH does not store the count, it ends with the last chain of the highest bucket
+            std::uint32_t header[4];
+
+            if (!read(gnu_hash_, header))
+                return 0;
+
+            const std::uint32_t nbuckets = header[0];
+            const std::uint32_t symoffset = header[1];
+            const ElfW(Addr) buckets = gnu_hash_ + sizeof(header) + header[2] * sizeof(ElfW(Addr));
+            const ElfW(Addr) chains = buckets + nbuckets * sizeof(std::uint32_t);
+
+            std::uint32_t last = 0;
+
+            for (std::uint32_t i = 0; i < nbuckets; ++i)
+            {
+                std::uint32_t bucket = 0;
+
+                if (!read(buckets + i * sizeof(std::uint32_t), bucket))
+                    return 0;
+
+                if (bucket > last)
+                    last = bucket;
+            }
+
+            if (last < symoffset)
+                return symoffset;
+
+            for (std::uint32_t hash = 0; !(hash & 1); ++last)
+            {
+                if (!read(chains + (last - symoffset) * sizeof(std::uint32_t), hash))
+                    return 0;
+            }
+
+            return last;
+        }
+
+        inline bool elf_image::name_equals(ElfW(Word) offset, const char* name, std::size_t length) const
+        {
+            if (strsz_ && (offset >= strsz_ || length >= strsz_ - offset))
+                return false;
+
+            const std::uintptr_t address = address_of(strtab_ + offset);
+
+            if (!address)
+                return false;
+
+            if (!accessor_)
+                return !std::strcmp(reinterpret_cast<const char*>(address), name);
+
+            char buffer[256];
+            std::vector<char> large;
+            char* text = buffer;
+
+            if (length + 1 > sizeof(buffer))
+            {
+                large.resize(length + 1);
+                text = large.data();
+            }
+
+            return read_raw(address, text, length + 1) && !std::memcmp(text, name, length + 1);
+        }
+
+        inline const char* elf_image::local_symbol_name(const ElfW(Sym) & sym) const
+        {
+            const std::uintptr_t address = address_of(strtab_ + sym.st_name);
+
+            return address ? reinterpret_cast<const char*>(address) : nullptr;
+        }
+
+        inline bool elf_image::symbol_name(const ElfW(Sym) & sym, std::string& name) const
+        {
+            name.clear();
+
+            const std::uintptr_t address = address_of(strtab_ + sym.st_name);
+
+            if (!address)
+                return false;
+
+            char buffer[64];
+
+            for (std::uintptr_t current = address;; current += sizeof(buffer))
+            {
+                std::size_t length = sizeof(buffer);
+
+                if (current - base_ + length > size_)
+                    length = size_ - (current - base_);
+
+                if (!length || !read_raw(current, buffer, length))
+                    return false;
+
+                const void* end = std::memchr(buffer, 0, length);
+
+                if (end)
+                {
+                    name.append(buffer, static_cast<std::size_t>(static_cast<const char*>(end) - buffer));
+                    return true;
+                }
+
+                name.append(buffer, length);
+            }
+        }
+
+        MEM_STRONG_INLINE std::uint32_t elf_image::gnu_hash(const char* name) noexcept
+        {
+            std::uint32_t hash = 5381;
+
+            for (const unsigned char* c = reinterpret_cast<const unsigned char*>(name); *c; ++c)
+                hash = (hash << 5) + hash + *c;
+
+            return hash;
+        }
+
+        MEM_STRONG_INLINE std::uint32_t elf_image::sysv_hash(const char* name) noexcept
+        {
+            std::uint32_t hash = 0;
+
+            for (const unsigned char* c = reinterpret_cast<const unsigned char*>(name); *c; ++c)
+            {
+                hash = (hash << 4) + *c;
+
+                const std::uint32_t high = hash & 0xF0000000;
+
+                if (high)
+                    hash ^= high >> 24;
+
+                hash &= ~high;
+            }
+
+            return hash;
+        }
+
+        inline std::size_t elf_image::find_symbol(const char* name) const
+        {
+            const std::size_t length = std::strlen(name);
+
+            ElfW(Sym) sym;
+
+            if (gnu_hash_)
+            {
+                std::uint32_t header[4];
+
+                if (!read(gnu_hash_, header) || !header[0] || !header[2])
+                    return 0;
+
+                const std::uint32_t nbuckets = header[0];
+                const std::uint32_t symoffset = header[1];
+                const std::uint32_t bloom_size = header[2];
+                const std::uint32_t bloom_shift = header[3];
+
+                const std::uint32_t hash = gnu_hash(name);
+
+                constexpr std::uint32_t word_bits = sizeof(ElfW(Addr)) * 8;
+
+                const ElfW(Addr) bloom = gnu_hash_ + sizeof(header);
+                ElfW(Addr) word = 0;
+
+                if (!read(bloom + ((hash / word_bits) % bloom_size) * sizeof(ElfW(Addr)), word))
+                    return 0;
+
+                const ElfW(Addr) mask =
+                    (ElfW(Addr)(1) << (hash % word_bits)) | (ElfW(Addr)(1) << ((hash >> bloom_shift) % word_bits));
+
+                if ((word & mask) != mask)
+                    return 0;
+
+                const ElfW(Addr) buckets = bloom + bloom_size * sizeof(ElfW(Addr));
+                const ElfW(Addr) chains = buckets + nbuckets * sizeof(std::uint32_t);
+
+                std::uint32_t index = 0;
+
+                if (!read(buckets + (hash % nbuckets) * sizeof(std::uint32_t), index) || (index < symoffset))
+                    return 0;
+
+                for (std::uint32_t chain_hash = 0; !(chain_hash & 1); ++index)
+                {
+                    if (!read(chains + (index - symoffset) * sizeof(std::uint32_t), chain_hash))
+                        return 0;
+
+                    if (((chain_hash | 1) == (hash | 1)) && symbol(index, sym) && is_export(sym) &&
+                        is_default_version(index) && name_equals(sym.st_name, name, length))
+                        return index;
+                }
+            }
+            else if (hash_)
+            {
+                std::uint32_t header[2];
+
+                if (!read(hash_, header) || !header[0])
+                    return 0;
+
+                const std::uint32_t nbucket = header[0];
+                const std::uint32_t nchain = header[1];
+
+                const ElfW(Addr) buckets = hash_ + sizeof(header);
+                const ElfW(Addr) chains = buckets + nbucket * sizeof(std::uint32_t);
+
+                std::uint32_t index = 0;
+
+                if (!read(buckets + (sysv_hash(name) % nbucket) * sizeof(std::uint32_t), index))
+                    return 0;
+
+                for (std::uint32_t steps = 0; index && (index < nchain) && (steps < nchain); ++steps)
+                {
+                    if (symbol(index, sym) && is_export(sym) && is_default_version(index) &&
+                        name_equals(sym.st_name, name, length))
+                        return index;
+
+                    if (!read(chains + index * sizeof(std::uint32_t), index))
+                        return 0;
+                }
+            }
+
+            return 0;
+        }
+    } // namespace internal
+
+    // The dynamic symbols of an ELF image, with the headers parsed once up front.
+    // After that, a lookup only reads the hash table, the symbols it leads to and their names.
+    class elf_exports
+    {
+    private:
+        internal::elf_image image_;
+        bool copy_names_ {false};
+
+    public:
+        explicit elf_exports(
+            module image, image_layout layout = image_layout::mapped, const data_accessor* accessor = nullptr);
+
+        // Whether the image has the symbol and hash tables needed for lookups
+        explicit operator bool() const noexcept;
+
+        // Looks name up through DT_GNU_HASH (or DT_HASH), returning the default version like dlsym.
+        // GNU indirect functions return their resolver. For image_layout::file, the result points into the file.
+        pointer find(const char* name) const;
+
+        // Calls func(name, index, address) for each symbol the image defines, stopping when it returns true.
+        // When reading through an accessor, name is only valid during the call.
+        template <typename Func>
+        void enumerate(Func func) const;
+    };
+
+    inline elf_exports::elf_exports(module image, image_layout layout, const data_accessor* accessor)
+        : image_(image, layout, accessor)
+        , copy_names_(accessor != nullptr)
+    {}
+
+    MEM_STRONG_INLINE elf_exports::operator bool() const noexcept
+    {
+        return image_.has_symbols();
+    }
+
+    template <typename Func>
+    inline void elf_exports::enumerate(Func func) const
+    {
+        const internal::elf_image& image = image_;
+
+        if (!image.has_symbols())
+            return;
+
+        const std::size_t count = image.symbol_count();
+
+        std::string name;
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            ElfW(Sym) sym;
+
+            if (!image.symbol(i, sym) || !image.is_export(sym))
+                continue;
+
+            const char* text = nullptr;
+
+            if (copy_names_)
+            {
+                if (!image.symbol_name(sym, name))
+                    continue;
+
+                text = name.c_str();
+            }
+            else
+            {
+                text = image.local_symbol_name(sym);
+            }
+
+            if (text && func(text, static_cast<std::uint32_t>(i), pointer(image.address_of(sym.st_value))))
+                break;
+        }
+    }
+
+    inline pointer elf_exports::find(const char* name) const
+    {
+        if (!image_.has_symbols())
+            return nullptr;
+
+        const std::size_t index = image_.find_symbol(name);
+
+        ElfW(Sym) sym;
+
+        if (!index || !image_.symbol(index, sym))
+            return nullptr;
+
+        return image_.address_of(sym.st_value);
+    }
+
+    template <typename Func>
+    MEM_STRONG_INLINE void module::enum_exports(Func func, image_layout layout, const data_accessor* accessor)
+    {
+        elf_exports(*this, layout, accessor).enumerate(std::move(func));
+    }
+
+    MEM_STRONG_INLINE pointer module::find_export(const char* name, image_layout layout, const data_accessor* accessor)
+    {
+        return elf_exports(*this, layout, accessor).find(name);
+    }
+
     MEM_STRONG_INLINE module module::main()
     {
         return named(nullptr);
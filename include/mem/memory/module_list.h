@@ -0,0 +1,257 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_MODULE_LIST_BRICK_H
+#define MEM_MODULE_LIST_BRICK_H
+
+#include <mem/memory/module.h>
+
+#if !defined(__unix__)
+#    error module_list requires dl_iterate_phdr
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mem
+{
+    struct module_entry
+    {
+        module image {};
+
+        // The path reported by the loader, empty for the main program
+        std::string path {};
+
+        const char* file_name() const noexcept;
+    };
+
+    // A snapshot of the loaded objects, indexed by file name and by address.
+    // It stays valid until the loader reports an object being added or removed.
+    class module_list
+    {
+    private:
+        std::vector<module_entry> modules_ {};
+
+        // File name -> index of the first object with that name, in loader order
+        std::unordered_map<std::string, std::size_t> by_name_ {};
+
+        // Indices sorted by start address
+        std::vector<std::size_t> by_address_ {};
+
+        unsigned long long adds_ {0};
+        unsigned long long subs_ {0};
+
+        static int collect_callback(struct dl_phdr_info* info, std::size_t size, void* data);
+        static int generation_callback(struct dl_phdr_info* info, std::size_t size, void* data);
+
+        static bool generation(unsigned long long& adds, unsigned long long& subs) noexcept;
+
+    public:
+        using iterator = std::vector<module_entry>::const_iterator;
+
+        module_list() = default;
+
+        // Walks the loader list once
+        static module_list snapshot();
+
+        // A per-thread snapshot, replaced by a new one when stale.
+        // Entries found in a snapshot stay valid for as long as it is held, even after a later refresh.
+        static std::shared_ptr<const module_list> cached();
+
+        // Whether objects were loaded or unloaded since the snapshot was taken
+        bool stale() const noexcept;
+
+        // Lookup by file name (nullptr or "" for the main program), like module::named
+        const module_entry* find(const char* name) const;
+
+        // The object whose load segments span address, or nullptr
+        const module_entry* find(pointer address) const noexcept;
+
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        iterator begin() const noexcept;
+        iterator end() const noexcept;
+
+        const module_entry& operator[](std::size_t index) const noexcept;
+    };
+
+    inline const char* module_entry::file_name() const noexcept
+    {
+        const char* name = std::strrchr(path.c_str(), '/');
+
+        return name ? name + 1 : path.c_str();
+    }
+
+    inline int module_list::collect_callback(struct dl_phdr_info* info, std::size_t size, void* data)
+    {
+        (void) size;
+
+        std::vector<module_entry>& modules = *static_cast<std::vector<module_entry>*>(data);
+
+        for (int i = 0; i < info->dlpi_phnum; ++i)
+        {
+            const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+
+            if (phdr.p_type == PT_LOAD)
+            {
+                module_entry entry;
+
+                entry.image = module(info->dlpi_addr + (phdr.p_vaddr & ~(phdr.p_align - 1)),
+                    total_mapping_size(info->dlpi_phdr, info->dlpi_phnum));
+
+                if (info->dlpi_name)
+                    entry.path = info->dlpi_name;
+
+                modules.push_back(std::move(entry));
+
+                break;
+            }
+        }
+
+        return 0;
+    }
+
+    inline int module_list::generation_callback(struct dl_phdr_info* info, std::size_t size, void* data)
+    {
+        // dlpi_adds and dlpi_subs are only present in newer versions of the structure
+        if (size < offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs))
+            return -1;
+
+        unsigned long long* counters = static_cast<unsigned long long*>(data);
+
+        counters[0] = info->dlpi_adds;
+        counters[1] = info->dlpi_subs;
+
+        return 1;
+    }
+
+    inline bool module_list::generation(unsigned long long& adds, unsigned long long& subs) noexcept
+    {
+        unsigned long long counters[2] {};
+
+        if (dl_iterate_phdr(&generation_callback, counters) != 1)
+            return false;
+
+        adds = counters[0];
+        subs = counters[1];
+
+        return true;
+    }
+
+    inline module_list module_list::snapshot()
+    {
+        module_list result;
+
+        // Read the counters first, so a concurrent change makes the snapshot stale rather than silently outdated
+        if (!generation(result.adds_, result.subs_))
+            result.adds_ = result.subs_ = ~0ull;
+
+        dl_iterate_phdr(&collect_callback, &result.modules_);
+
+        result.by_name_.reserve(result.modules_.size());
+        result.by_address_.resize(result.modules_.size());
+
+        for (std::size_t i = 0; i < result.modules_.size(); ++i)
+        {
+            result.by_name_.emplace(result.modules_[i].file_name(), i);
+            result.by_address_[i] = i;
+        }
+
+        std::sort(result.by_address_.begin(), result.by_address_.end(), [&result](std::size_t lhs, std::size_t rhs) {
+            return result.modules_[lhs].image.start < result.modules_[rhs].image.start;
+        });
+
+        return result;
+    }
+
+    inline std::shared_ptr<const module_list> module_list::cached()
+    {
+        static thread_local std::shared_ptr<const module_list> instance;
+
+        if (!instance || instance->empty() || instance->stale())
+            instance = std::make_shared<const module_list>(snapshot());
+
+        return instance;
+    }
+
+    inline bool module_list::stale() const noexcept
+    {
+        unsigned long long adds = 0;
+        unsigned long long subs = 0;
+
+        // Without the counters there is no way to tell, so always refresh
+        if (!generation(adds, subs))
+            return true;
+
+        return (adds != adds_) || (subs != subs_);
+    }
+
+    inline const module_entry* module_list::find(const char* name) const
+    {
+        const auto iter = by_name_.find(name ? name : "");
+
+        return (iter != by_name_.end()) ? &modules_[iter->second] : nullptr;
+    }
+
+    inline const module_entry* module_list::find(pointer address) const noexcept
+    {
+        // First module starting after address
+        auto iter = std::upper_bound(by_address_.begin(), by_address_.end(), address,
+            [this](pointer lhs, std::size_t rhs) { return lhs < modules_[rhs].image.start; });
+
+        if (iter == by_address_.begin())
+            return nullptr;
+
+        const module_entry& entry = modules_[*(iter - 1)];
+
+        return entry.image.contains(address) ? &entry : nullptr;
+    }
+
+    MEM_STRONG_INLINE std::size_t module_list::size() const noexcept
+    {
+        return modules_.size();
+    }
+
+    MEM_STRONG_INLINE bool module_list::empty() const noexcept
+    {
+        return modules_.empty();
+    }
+
+    MEM_STRONG_INLINE module_list::iterator module_list::begin() const noexcept
+    {
+        return modules_.begin();
+    }
+
+    MEM_STRONG_INLINE module_list::iterator module_list::end() const noexcept
+    {
+        return modules_.end();
+    }
+
+    MEM_STRONG_INLINE const module_entry& module_list::operator[](std::size_t index) const noexcept
+    {
+        return modules_[index];
+    }
+} // namespace mem
+
+#endif // MEM_MODULE_LIST_BRICK_H
@@ -0,0 +1,399 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_MSVC_RTTI_BRICK_H
+#define MEM_MSVC_RTTI_BRICK_H
+
+#include <mem/memory/pe_image.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mem
+{
+    namespace rtti
+    {
+        struct rtti_vtable
+        {
+            std::uint32_t rva {0};     // The first virtual function slot
+            std::uint32_t locator {0}; // RVA of the complete object locator preceding it
+            std::uint32_t offset {0};  // Offset of this vtable in the complete class
+        };
+
+        struct rtti_type
+        {
+            // RVA of the TypeDescriptor
+            std::uint32_t type_descriptor {0};
+
+            // ".?AV...@@", pointing into the image buffer
+            const char* decorated_name {nullptr};
+
+            // Decorated names of all base classes, in hierarchy order
+            std::vector<const char*> bases {};
+
+            // Sorted by offset
+            std::vector<rtti_vtable> vtables {};
+        };
+
+        // MSVC RTTI of a PE image, read from its buffer so it works for any host and either layout.
+        // Complete object locators are enumerated once, and types are keyed by decorated name.
+        class rtti_index
+        {
+        private:
+            pe_image image_ {};
+
+            std::vector<rtti_type> types_ {};
+            std::unordered_map<std::string, std::size_t> by_name_ {};
+
+            // Only built by the first find_demangled
+            mutable std::unordered_map<std::string, std::size_t> by_demangled_ {};
+            mutable bool demangled_ {false};
+
+            std::uint32_t to_rva(std::uint32_t field) const noexcept;
+            bool read_word(const byte* data, std::uint64_t& value) const noexcept;
+
+            const char* type_name(std::uint32_t type_descriptor) const noexcept;
+
+            // Index of the type described by the locator, or SIZE_MAX
+            std::size_t add_locator(std::uint32_t locator);
+
+        public:
+            using iterator = std::vector<rtti_type>::const_iterator;
+
+            rtti_index() = default;
+
+            explicit rtti_index(const pe_image& image);
+
+            const pe_image& image() const noexcept;
+
+            const rtti_type* find(const char* decorated_name) const;
+
+            // Lookup by demangle() name. The first call demangles every type.
+            const rtti_type* find_demangled(const char* name) const;
+
+            std::size_t size() const noexcept;
+            bool empty() const noexcept;
+
+            iterator begin() const noexcept;
+            iterator end() const noexcept;
+
+            // Undecorates type descriptor names such as ".?AVFoo@ns@@" to "ns::Foo".
+            // Templates and back references are not supported, and are returned unchanged.
+            static std::string demangle(const char* decorated_name);
+        };
+
+        namespace internal
+        {
+            struct msvc_locator
+            {
+                std::uint32_t signature;
+                std::uint32_t offset;
+                std::uint32_t cd_offset;
+                std::uint32_t type_descriptor;
+                std::uint32_t class_descriptor;
+                std::uint32_t self; // 64-bit only
+            };
+
+            struct msvc_hierarchy
+            {
+                std::uint32_t signature;
+                std::uint32_t attributes;
+                std::uint32_t base_count;
+                std::uint32_t base_array;
+            };
+        } // namespace internal
+
+        inline rtti_index::rtti_index(const pe_image& image)
+            : image_(image)
+        {
+            if (!image_)
+                return;
+
+            const std::size_t word_size = image_.is_64() ? 8 : 4;
+
+            // Locator RVA -> type index, or SIZE_MAX if it is not a valid locator
+            std::unordered_map<std::uint32_t, std::size_t> locators;
+
+            for (const pe::section_header& section : image_.sections())
+            {
+                if ((section.Characteristics & pe::scn_mem_execute) || !(section.Characteristics & pe::scn_mem_read))
+                    continue;
+
+                std::uint32_t size = section.VirtualSize;
+
+                if ((image_.layout() == image_layout::file) && (section.SizeOfRawData < size))
+                    size = section.SizeOfRawData;
+
+                const pointer data = image_.rva_to_pointer(section.VirtualAddress, size);
+
+                if (!data)
+                    continue;
+
+                // Every vtable is preceded by a pointer to its complete object locator
+                for (std::uint32_t i = 0; i + word_size * 2 <= size; i += static_cast<std::uint32_t>(word_size))
+                {
+                    std::uint64_t value = 0;
+
+                    if (!read_word(data.add(i).as<const byte*>(), value))
+                        continue;
+
+                    // Cheap range filter before any lookup
+                    if ((value < image_.image_base()) || (value - image_.image_base() >= image_.size_of_image()))
+                        continue;
+
+                    const std::uint32_t locator = static_cast<std::uint32_t>(value - image_.image_base());
+
+                    auto iter = locators.find(locator);
+
+                    if (iter == locators.end())
+                        iter = locators.emplace(locator, add_locator(locator)).first;
+
+                    if (iter->second == SIZE_MAX)
+                        continue;
+
+                    internal::msvc_locator col {};
+                    image_.read_rva(locator, col);
+
+                    rtti_vtable vtable;
+                    vtable.rva = section.VirtualAddress + i + static_cast<std::uint32_t>(word_size);
+                    vtable.locator = locator;
+                    vtable.offset = col.offset;
+
+                    types_[iter->second].vtables.push_back(vtable);
+                }
+            }
+
+            for (rtti_type& type : types_)
+            {
+                std::sort(type.vtables.begin(), type.vtables.end(), [](const rtti_vtable& lhs, const rtti_vtable& rhs) {
+                    return (lhs.offset != rhs.offset) ? (lhs.offset < rhs.offset) : (lhs.rva < rhs.rva);
+                });
+            }
+        }
+
+        MEM_STRONG_INLINE std::uint32_t rtti_index::to_rva(std::uint32_t field) const noexcept
+        {
+            // x86 locators hold addresses, x64 locators hold RVAs
+            return image_.is_64() ? field : field - static_cast<std::uint32_t>(image_.image_base());
+        }
+
+        MEM_STRONG_INLINE bool rtti_index::read_word(const byte* data, std::uint64_t& value) const noexcept
+        {
+            if (image_.is_64())
+            {
+                std::memcpy(&value, data, sizeof(std::uint64_t));
+            }
+            else
+            {
+                std::uint32_t word = 0;
+                std::memcpy(&word, data, sizeof(word));
+                value = word;
+            }
+
+            return value != 0;
+        }
+
+        inline const char* rtti_index::type_name(std::uint32_t type_descriptor) const noexcept
+        {
+            // The name follows the vftable and spare pointers
+            const std::uint32_t word_size = image_.is_64() ? 8 : 4;
+
+            const char* name = image_.string_at(type_descriptor + word_size * 2);
+
+            if (!name || std::strncmp(name, ".?A", 3))
+                return nullptr;
+
+            return name;
+        }
+
+        inline std::size_t rtti_index::add_locator(std::uint32_t locator)
+        {
+            internal::msvc_locator col {};
+
+            const std::size_t col_size = image_.is_64() ? sizeof(col) : offsetof(internal::msvc_locator, self);
+
+            if (!image_.rva_to_pointer(locator, col_size))
+                return SIZE_MAX;
+
+            image_.read_rva(locator, col);
+
+            if (col.signature != (image_.is_64() ? 1u : 0u))
+                return SIZE_MAX;
+
+            if (image_.is_64() && (col.self != locator))
+                return SIZE_MAX;
+
+            const std::uint32_t type_descriptor = to_rva(col.type_descriptor);
+            const char* name = type_name(type_descriptor);
+
+            if (!name)
+                return SIZE_MAX;
+
+            const auto found = by_name_.find(name);
+
+            if (found != by_name_.end())
+                return found->second;
+
+            rtti_type type;
+            type.type_descriptor = type_descriptor;
+            type.decorated_name = name;
+
+            internal::msvc_hierarchy hierarchy {};
+
+            if (image_.read_rva(to_rva(col.class_descriptor), hierarchy))
+            {
+                // The first entry is the class itself
+                for (std::uint32_t i = 1; i < hierarchy.base_count; ++i)
+                {
+                    std::uint32_t descriptor = 0;
+                    std::uint32_t base_type = 0;
+
+                    if (!image_.read_rva(to_rva(hierarchy.base_array) + i * 4, descriptor) ||
+                        !image_.read_rva(to_rva(descriptor), base_type))
+                        break;
+
+                    if (const char* base_name = type_name(to_rva(base_type)))
+                        type.bases.push_back(base_name);
+                }
+            }
+
+            by_name_.emplace(name, types_.size());
+            types_.push_back(std::move(type));
+
+            return types_.size() - 1;
+        }
+
+        MEM_STRONG_INLINE const pe_image& rtti_index::image() const noexcept
+        {
+            return image_;
+        }
+
+        inline const rtti_type* rtti_index::find(const char* decorated_name) const
+        {
+            const auto iter = by_name_.find(decorated_name);
+
+            return (iter != by_name_.end()) ? &types_[iter->second] : nullptr;
+        }
+
+        inline const rtti_type* rtti_index::find_demangled(const char* name) const
+        {
+            if (!demangled_)
+            {
+                by_demangled_.reserve(types_.size());
+
+                for (std::size_t i = 0; i < types_.size(); ++i)
+                    by_demangled_.emplace(demangle(types_[i].decorated_name), i);
+
+                demangled_ = true;
+            }
+
+            const auto iter = by_demangled_.find(name);
+
+            return (iter != by_demangled_.end()) ? &types_[iter->second] : nullptr;
+        }
+
+        MEM_STRONG_INLINE std::size_t rtti_index::size() const noexcept
+        {
+            return types_.size();
+        }
+
+        MEM_STRONG_INLINE bool rtti_index::empty() const noexcept
+        {
+            return types_.empty();
+        }
+
+        MEM_STRONG_INLINE rtti_index::iterator rtti_index::begin() const noexcept
+        {
+            return types_.begin();
+        }
+
+        MEM_STRONG_INLINE rtti_index::iterator rtti_index::end() const noexcept
+        {
+            return types_.end();
+        }
+
+        inline std::string rtti_index::demangle(const char* decorated_name)
+        {
+            const char* current = decorated_name;
+
+            if (std::strncmp(current, ".?A", 3))
+                return decorated_name;
+
+            current += 3;
+
+            // Class, struct, union, or enum with its underlying type
+            if (*current == 'V' || *current == 'U' || *current == 'T')
+                current += 1;
+            else if (*current == 'W' && current[1] >= '0' && current[1] <= '7')
+                current += 2;
+            else
+                return decorated_name;
+
+            // Fragments run from the innermost scope outwards, and end with an empty one
+            std::vector<std::string> scopes;
+
+            while (*current != '@')
+            {
+                const char* end = std::strchr(current, '@');
+
+                if (!end || end == current)
+                    return decorated_name;
+
+                if (*current == '?')
+                {
+                    if (std::strncmp(current, "?A0x", 4))
+                        return decorated_name;
+
+                    scopes.emplace_back("`anonymous namespace'");
+                }
+                else if (*current >= '0' && *current <= '9')
+                {
+                    return decorated_name;
+                }
+                else
+                {
+                    scopes.emplace_back(current, end);
+                }
+
+                current = end + 1;
+            }
+
+            if (scopes.empty() || current[1] != '\0')
+                return decorated_name;
+
+            std::string result;
+
+            for (auto iter = scopes.rbegin(); iter != scopes.rend(); ++iter)
+            {
+                if (!result.empty())
+                    result += "::";
+
+                result += *iter;
+            }
+
+            return result;
+        }
+    } // namespace rtti
+} // namespace mem
+
+#endif // MEM_MSVC_RTTI_BRICK_H
@@ -0,0 +1,684 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_PE_IMAGE_BRICK_H
+#define MEM_PE_IMAGE_BRICK_H
+
+#include <mem/containers/slice.h>
+#include <mem/memory/common.h>
+#include <mem/memory/prot_flags.h>
+#include <mem/memory/region.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace mem
+{
+    // Platform independent PE structures, matching the layout of their <Windows.h> counterparts.
+    // Fields are read as little-endian host values.
+    namespace pe
+    {
+        constexpr const std::uint16_t dos_signature {0x5A4D};     // MZ
+        constexpr const std::uint32_t nt_signature {0x00004550};  // PE\0\0
+        constexpr const std::uint16_t optional_magic32 {0x10B};
+        constexpr const std::uint16_t optional_magic64 {0x20B};
+
+        constexpr const std::size_t directory_count {16};
+
+        constexpr const std::size_t directory_export {0};
+        constexpr const std::size_t directory_import {1};
+        constexpr const std::size_t directory_resource {2};
+        constexpr const std::size_t directory_exception {3};
+        constexpr const std::size_t directory_basereloc {5};
+        constexpr const std::size_t directory_debug {6};
+        constexpr const std::size_t directory_tls {9};
+        constexpr const std::size_t directory_iat {12};
+
+        constexpr const std::uint32_t scn_cnt_code {0x00000020};
+        constexpr const std::uint32_t scn_mem_execute {0x20000000};
+        constexpr const std::uint32_t scn_mem_read {0x40000000};
+        constexpr const std::uint32_t scn_mem_write {0x80000000};
+
+        struct dos_header
+        {
+            std::uint16_t e_magic;
+            std::uint16_t e_cblp;
+            std::uint16_t e_cp;
+            std::uint16_t e_crlc;
+            std::uint16_t e_cparhdr;
+            std::uint16_t e_minalloc;
+            std::uint16_t e_maxalloc;
+            std::uint16_t e_ss;
+            std::uint16_t e_sp;
+            std::uint16_t e_csum;
+            std::uint16_t e_ip;
+            std::uint16_t e_cs;
+            std::uint16_t e_lfarlc;
+            std::uint16_t e_ovno;
+            std::uint16_t e_res[4];
+            std::uint16_t e_oemid;
+            std::uint16_t e_oeminfo;
+            std::uint16_t e_res2[10];
+            std::int32_t e_lfanew;
+        };
+
+        struct file_header
+        {
+            std::uint16_t Machine;
+            std::uint16_t NumberOfSections;
+            std::uint32_t TimeDateStamp;
+            std::uint32_t PointerToSymbolTable;
+            std::uint32_t NumberOfSymbols;
+            std::uint16_t SizeOfOptionalHeader;
+            std::uint16_t Characteristics;
+        };
+
+        struct data_directory
+        {
+            std::uint32_t VirtualAddress;
+            std::uint32_t Size;
+        };
+
+        struct optional_header32
+        {
+            std::uint16_t Magic;
+            std::uint8_t MajorLinkerVersion;
+            std::uint8_t MinorLinkerVersion;
+            std::uint32_t SizeOfCode;
+            std::uint32_t SizeOfInitializedData;
+            std::uint32_t SizeOfUninitializedData;
+            std::uint32_t AddressOfEntryPoint;
+            std::uint32_t BaseOfCode;
+            std::uint32_t BaseOfData;
+            std::uint32_t ImageBase;
+            std::uint32_t SectionAlignment;
+            std::uint32_t FileAlignment;
+            std::uint16_t MajorOperatingSystemVersion;
+            std::uint16_t MinorOperatingSystemVersion;
+            std::uint16_t MajorImageVersion;
+            std::uint16_t MinorImageVersion;
+            std::uint16_t MajorSubsystemVersion;
+            std::uint16_t MinorSubsystemVersion;
+            std::uint32_t Win32VersionValue;
+            std::uint32_t SizeOfImage;
+            std::uint32_t SizeOfHeaders;
+            std::uint32_t CheckSum;
+            std::uint16_t Subsystem;
+            std::uint16_t DllCharacteristics;
+            std::uint32_t SizeOfStackReserve;
+            std::uint32_t SizeOfStackCommit;
+            std::uint32_t SizeOfHeapReserve;
+            std::uint32_t SizeOfHeapCommit;
+            std::uint32_t LoaderFlags;
+            std::uint32_t NumberOfRvaAndSizes;
+            data_directory DataDirectory[directory_count];
+        };
+
+        struct optional_header64
+        {
+            std::uint16_t Magic;
+            std::uint8_t MajorLinkerVersion;
+            std::uint8_t MinorLinkerVersion;
+            std::uint32_t SizeOfCode;
+            std::uint32_t SizeOfInitializedData;
+            std::uint32_t SizeOfUninitializedData;
+            std::uint32_t AddressOfEntryPoint;
+            std::uint32_t BaseOfCode;
+            std::uint64_t ImageBase;
+            std::uint32_t SectionAlignment;
+            std::uint32_t FileAlignment;
+            std::uint16_t MajorOperatingSystemVersion;
+            std::uint16_t MinorOperatingSystemVersion;
+            std::uint16_t MajorImageVersion;
+            std::uint16_t MinorImageVersion;
+            std::uint16_t MajorSubsystemVersion;
+            std::uint16_t MinorSubsystemVersion;
+            std::uint32_t Win32VersionValue;
+            std::uint32_t SizeOfImage;
+            std::uint32_t SizeOfHeaders;
+            std::uint32_t CheckSum;
+            std::uint16_t Subsystem;
+            std::uint16_t DllCharacteristics;
+            std::uint64_t SizeOfStackReserve;
+            std::uint64_t SizeOfStackCommit;
+            std::uint64_t SizeOfHeapReserve;
+            std::uint64_t SizeOfHeapCommit;
+            std::uint32_t LoaderFlags;
+            std::uint32_t NumberOfRvaAndSizes;
+            data_directory DataDirectory[directory_count];
+        };
+
+        struct section_header
+        {
+            char Name[8];
+            std::uint32_t VirtualSize;
+            std::uint32_t VirtualAddress;
+            std::uint32_t SizeOfRawData;
+            std::uint32_t PointerToRawData;
+            std::uint32_t PointerToRelocations;
+            std::uint32_t PointerToLinenumbers;
+            std::uint16_t NumberOfRelocations;
+            std::uint16_t NumberOfLinenumbers;
+            std::uint32_t Characteristics;
+        };
+
+        struct export_directory
+        {
+            std::uint32_t Characteristics;
+            std::uint32_t TimeDateStamp;
+            std::uint16_t MajorVersion;
+            std::uint16_t MinorVersion;
+            std::uint32_t Name;
+            std::uint32_t Base;
+            std::uint32_t NumberOfFunctions;
+            std::uint32_t NumberOfNames;
+            std::uint32_t AddressOfFunctions;
+            std::uint32_t AddressOfNames;
+            std::uint32_t AddressOfNameOrdinals;
+        };
+
+        static_assert(sizeof(dos_header) == 64, "Invalid dos_header");
+        static_assert(sizeof(file_header) == 20, "Invalid file_header");
+        static_assert(sizeof(optional_header32) == 224, "Invalid optional_header32");
+        static_assert(sizeof(optional_header64) == 240, "Invalid optional_header64");
+        static_assert(sizeof(section_header) == 40, "Invalid section_header");
+        static_assert(sizeof(export_directory) == 40, "Invalid export_directory");
+    } // namespace pe
+
+    struct pe_export
+    {
+        const char* name {nullptr};
+        std::uint16_t ordinal {0};
+        std::uint32_t rva {0};
+
+        // The "dll.function" string of forwarded exports
+        const char* forwarder {nullptr};
+    };
+
+    // Parses a PE image held in any buffer, independently of the host platform
+    class pe_image
+    {
+    private:
+        region image_ {};
+        image_layout layout_ {image_layout::mapped};
+
+        bool valid_ {false};
+        bool is_64_ {false};
+
+        pe::file_header file_header_ {};
+        std::uint64_t image_base_ {0};
+        std::uint32_t entry_point_ {0};
+        std::uint32_t size_of_image_ {0};
+        std::uint32_t size_of_headers_ {0};
+
+        pe::data_directory directories_[pe::directory_count] {};
+        std::vector<pe::section_header> sections_ {};
+
+        pe::export_directory exports_ {};
+        bool has_exports_ {false};
+
+        template <typename T>
+        bool read(std::size_t offset, T& value) const noexcept;
+
+        bool make_export(std::uint32_t index, const char* name, pe_export& result) const noexcept;
+
+    public:
+        pe_image() = default;
+
+        pe_image(region image, image_layout layout = image_layout::mapped);
+
+        explicit operator bool() const noexcept;
+
+        region image() const noexcept;
+        image_layout layout() const noexcept;
+
+        bool is_64() const noexcept;
+        std::uint16_t machine() const noexcept;
+        std::uint64_t image_base() const noexcept;
+        std::uint32_t entry_point() const noexcept;
+        std::uint32_t size_of_image() const noexcept;
+
+        const pe::file_header& file_header() const noexcept;
+        pe::data_directory directory(std::size_t index) const noexcept;
+
+        slice<const pe::section_header> sections() const noexcept;
+
+        const pe::section_header* find_section(const char* name) const noexcept;
+        const pe::section_header* section_from_rva(std::uint32_t rva) const noexcept;
+
+        // The address of size bytes at rva within the buffer, or nullptr if they are not all present
+        pointer rva_to_pointer(std::uint32_t rva, std::size_t size = 1) const noexcept;
+
+        // A NUL terminated string at rva which lies within the buffer, or nullptr
+        const char* string_at(std::uint32_t rva) const noexcept;
+
+        // Copies the (possibly unaligned) value at rva, if it is within the buffer
+        template <typename T>
+        bool read_rva(std::uint32_t rva, T& value) const noexcept;
+
+        // Calls func(range, prot) for each section, with range inside the buffer
+        template <typename Func>
+        void enum_segments(Func func) const;
+
+        // Calls func(name, ordinal, address) for each export, stopping when it returns true.
+        // Unnamed exports have a null name, forwarded exports point to their forwarder string.
+        template <typename Func>
+        void enum_exports(Func func) const;
+
+        // Binary search over the sorted export name table
+        bool find_export(const char* name, pe_export& result) const noexcept;
+        bool find_export(std::uint16_t ordinal, pe_export& result) const noexcept;
+
+        // The address of a non-forwarded export, or nullptr
+        pointer find_export(const char* name) const noexcept;
+    };
+
+    template <typename T>
+    MEM_STRONG_INLINE bool pe_image::read(std::size_t offset, T& value) const noexcept
+    {
+        if ((offset > image_.size) || (sizeof(T) > image_.size - offset))
+            return false;
+
+        std::memcpy(&value, image_.start.add(offset).as<const void*>(), sizeof(T));
+
+        return true;
+    }
+
+    template <typename T>
+    MEM_STRONG_INLINE bool pe_image::read_rva(std::uint32_t rva, T& value) const noexcept
+    {
+        const pointer address = rva_to_pointer(rva, sizeof(T));
+
+        if (!address)
+            return false;
+
+        std::memcpy(&value, address.as<const void*>(), sizeof(T));
+
+        return true;
+    }
+
+    inline pe_image::pe_image(region image, image_layout layout)
+        : image_(image)
+        , layout_(layout)
+    {
+        pe::dos_header dos;
+
+        if (!read(0, dos) || (dos.e_magic != pe::dos_signature) || (dos.e_lfanew < 0))
+            return;
+
+        const std::size_t nt_offset = static_cast<std::size_t>(dos.e_lfanew);
+
+        std::uint32_t signature = 0;
+
+        if (!read(nt_offset, signature) || (signature != pe::nt_signature))
+            return;
+
+        if (!read(nt_offset + sizeof(signature), file_header_))
+            return;
+
+        const std::size_t optional_offset = nt_offset + sizeof(signature) + sizeof(pe::file_header);
+
+        std::uint16_t magic = 0;
+
+        if (!read(optional_offset, magic))
+            return;
+
+        std::uint32_t directory_count = 0;
+
+        if (magic == pe::optional_magic64)
+        {
+            pe::optional_header64 optional {};
+
+            if (file_header_.SizeOfOptionalHeader < offsetof(pe::optional_header64, DataDirectory) ||
+                !read(optional_offset, optional))
+                return;
+
+            is_64_ = true;
+            image_base_ = optional.ImageBase;
+            entry_point_ = optional.AddressOfEntryPoint;
+            size_of_image_ = optional.SizeOfImage;
+            size_of_headers_ = optional.SizeOfHeaders;
+            directory_count = (std::min)(optional.NumberOfRvaAndSizes,
+                static_cast<std::uint32_t>(
+                    (file_header_.SizeOfOptionalHeader - offsetof(pe::optional_header64, DataDirectory)) /
+                    sizeof(pe::data_directory)));
+            std::memcpy(directories_, optional.DataDirectory, sizeof(directories_));
+        }
+        else if (magic == pe::optional_magic32)
+        {
+            pe::optional_header32 optional {};
+
+            if (file_header_.SizeOfOptionalHeader < offsetof(pe::optional_header32, DataDirectory) ||
+                !read(optional_offset, optional))
+                return;
+
+            image_base_ = optional.ImageBase;
+            entry_point_ = optional.AddressOfEntryPoint;
+            size_of_image_ = optional.SizeOfImage;
+            size_of_headers_ = optional.SizeOfHeaders;
+            directory_count = (std::min)(optional.NumberOfRvaAndSizes,
+                static_cast<std::uint32_t>(
+                    (file_header_.SizeOfOptionalHeader - offsetof(pe::optional_header32, DataDirectory)) /
+                    sizeof(pe::data_directory)));
+            std::memcpy(directories_, optional.DataDirectory, sizeof(directories_));
+        }
+        else
+        {
+            return;
+        }
+
+        // Directories past the optional header would be read from the section headers
+        for (std::size_t i = directory_count; i < pe::directory_count; ++i)
+            directories_[i] = {};
+
+        const std::size_t section_offset = optional_offset + file_header_.SizeOfOptionalHeader;
+
+        sections_.resize(file_header_.NumberOfSections);
+
+        for (std::size_t i = 0; i < sections_.size(); ++i)
+        {
+            if (!read(section_offset + i * sizeof(pe::section_header), sections_[i]))
+                return;
+        }
+
+        valid_ = true;
+
+        const pe::data_directory& exports = directories_[pe::directory_export];
+
+        has_exports_ = (exports.Size >= sizeof(pe::export_directory)) && read_rva(exports.VirtualAddress, exports_);
+
+        // The counts come from the file, so only trust them when their tables are really there
+        has_exports_ = has_exports_ &&
+            rva_to_pointer(exports_.AddressOfFunctions, std::size_t(exports_.NumberOfFunctions) * 4) &&
+            rva_to_pointer(exports_.AddressOfNames, std::size_t(exports_.NumberOfNames) * 4) &&
+            rva_to_pointer(exports_.AddressOfNameOrdinals, std::size_t(exports_.NumberOfNames) * 2);
+    }
+
+    MEM_STRONG_INLINE pe_image::operator bool() const noexcept
+    {
+        return valid_;
+    }
+
+    MEM_STRONG_INLINE region pe_image::image() const noexcept
+    {
+        return image_;
+    }
+
+    MEM_STRONG_INLINE image_layout pe_image::layout() const noexcept
+    {
+        return layout_;
+    }
+
+    MEM_STRONG_INLINE bool pe_image::is_64() const noexcept
+    {
+        return is_64_;
+    }
+
+    MEM_STRONG_INLINE std::uint16_t pe_image::machine() const noexcept
+    {
+        return file_header_.Machine;
+    }
+
+    MEM_STRONG_INLINE std::uint64_t pe_image::image_base() const noexcept
+    {
+        return image_base_;
+    }
+
+    MEM_STRONG_INLINE std::uint32_t pe_image::entry_point() const noexcept
+    {
+        return entry_point_;
+    }
+
+    MEM_STRONG_INLINE std::uint32_t pe_image::size_of_image() const noexcept
+    {
+        return size_of_image_;
+    }
+
+    MEM_STRONG_INLINE const pe::file_header& pe_image::file_header() const noexcept
+    {
+        return file_header_;
+    }
+
+    MEM_STRONG_INLINE pe::data_directory pe_image::directory(std::size_t index) const noexcept
+    {
+        return (index < pe::directory_count) ? directories_[index] : pe::data_directory {};
+    }
+
+    MEM_STRONG_INLINE slice<const pe::section_header> pe_image::sections() const noexcept
+    {
+        return {sections_.data(), sections_.size()};
+    }
+
+    inline const pe::section_header* pe_image::find_section(const char* name) const noexcept
+    {
+        const std::size_t length = std::strlen(name);
+
+        if (length > sizeof(pe::section_header::Name))
+            return nullptr;
+
+        for (const pe::section_header& section : sections_)
+        {
+            if (!std::memcmp(section.Name, name, length) &&
+                ((length == sizeof(section.Name)) || (section.Name[length] == '\0')))
+                return &section;
+        }
+
+        return nullptr;
+    }
+
+    inline const pe::section_header* pe_image::section_from_rva(std::uint32_t rva) const noexcept
+    {
+        for (const pe::section_header& section : sections_)
+        {
+            const std::uint32_t size = (section.VirtualSize > section.SizeOfRawData) ? section.VirtualSize
+                                                                                     : section.SizeOfRawData;
+
+            if ((rva >= section.VirtualAddress) && (rva - section.VirtualAddress < size))
+                return &section;
+        }
+
+        return nullptr;
+    }
+
+    inline pointer pe_image::rva_to_pointer(std::uint32_t rva, std::size_t size) const noexcept
+    {
+        std::size_t offset = rva;
+
+        if ((layout_ == image_layout::file) && (rva >= size_of_headers_))
+        {
+            const pe::section_header* section = section_from_rva(rva);
+
+            if (!section)
+                return nullptr;
+
+            const std::size_t section_offset = rva - section->VirtualAddress;
+
+            // The tail of a section past its raw data is zero filled, and not in the file
+            if ((section_offset > section->SizeOfRawData) || (size > section->SizeOfRawData - section_offset))
+                return nullptr;
+
+            offset = section->PointerToRawData + section_offset;
+        }
+
+        if ((offset > image_.size) || (size > image_.size - offset))
+            return nullptr;
+
+        return image_.start.add(offset);
+    }
+
+    inline const char* pe_image::string_at(std::uint32_t rva) const noexcept
+    {
+        const pointer address = rva_to_pointer(rva);
+
+        if (!address)
+            return nullptr;
+
+        const std::size_t remaining = image_.size - static_cast<std::size_t>(address - image_.start);
+
+        return std::memchr(address.as<const void*>(), 0, remaining) ? address.as<const char*>() : nullptr;
+    }
+
+    template <typename Func>
+    inline void pe_image::enum_segments(Func func) const
+    {
+        for (const pe::section_header& section : sections_)
+        {
+            std::uint32_t size = section.VirtualSize;
+
+            if (layout_ == image_layout::file && section.SizeOfRawData < size)
+                size = section.SizeOfRawData;
+
+            if (!size)
+                continue;
+
+            const pointer start = rva_to_pointer(section.VirtualAddress, size);
+
+            if (!start)
+                continue;
+
+            prot_flags prot = prot_flags::NONE;
+
+            if (section.Characteristics & pe::scn_mem_read)
+                prot |= prot_flags::R;
+
+            if (section.Characteristics & pe::scn_mem_write)
+                prot |= prot_flags::W;
+
+            if (section.Characteristics & pe::scn_mem_execute)
+                prot |= prot_flags::X;
+
+            if (func(region(start, size), prot))
+                return;
+        }
+    }
+
+    inline bool pe_image::make_export(std::uint32_t index, const char* name, pe_export& result) const noexcept
+    {
+        if (index >= exports_.NumberOfFunctions)
+            return false;
+
+        std::uint32_t rva = 0;
+
+        if (!read_rva(exports_.AddressOfFunctions + index * 4, rva))
+            return false;
+
+        const pe::data_directory& dir = directories_[pe::directory_export];
+
+        result.name = name;
+        result.ordinal = static_cast<std::uint16_t>(exports_.Base + index);
+        result.rva = rva;
+        result.forwarder = ((rva >= dir.VirtualAddress) && (rva - dir.VirtualAddress < dir.Size)) ? string_at(rva)
+                                                                                                 : nullptr;
+
+        return true;
+    }
+
+    template <typename Func>
+    inline void pe_image::enum_exports(Func func) const
+    {
+        if (!has_exports_)
+            return;
+
+        std::vector<const char*> names(exports_.NumberOfFunctions);
+
+        for (std::uint32_t i = 0; i < exports_.NumberOfNames; ++i)
+        {
+            std::uint32_t name_rva = 0;
+            std::uint16_t index = 0;
+
+            if (read_rva(exports_.AddressOfNames + i * 4, name_rva) &&
+                read_rva(exports_.AddressOfNameOrdinals + i * 2, index) && (index < names.size()))
+                names[index] = string_at(name_rva);
+        }
+
+        for (std::uint32_t i = 0; i < exports_.NumberOfFunctions; ++i)
+        {
+            pe_export entry;
+
+            if (!make_export(i, names[i], entry) || !entry.rva)
+                continue;
+
+            if (func(entry.name, entry.ordinal, rva_to_pointer(entry.rva)))
+                break;
+        }
+    }
+
+    inline bool pe_image::find_export(const char* name, pe_export& result) const noexcept
+    {
+        if (!has_exports_)
+            return false;
+
+        std::uint32_t low = 0;
+        std::uint32_t high = exports_.NumberOfNames;
+
+        while (low < high)
+        {
+            const std::uint32_t mid = low + (high - low) / 2;
+
+            std::uint32_t name_rva = 0;
+
+            if (!read_rva(exports_.AddressOfNames + mid * 4, name_rva))
+                return false;
+
+            const char* current = string_at(name_rva);
+
+            if (!current)
+                return false;
+
+            const int cmp = std::strcmp(name, current);
+
+            if (cmp == 0)
+            {
+                std::uint16_t index = 0;
+
+                return read_rva(exports_.AddressOfNameOrdinals + mid * 2, index) && make_export(index, current, result);
+            }
+
+            if (cmp < 0)
+                high = mid;
+            else
+                low = mid + 1;
+        }
+
+        return false;
+    }
+
+    inline bool pe_image::find_export(std::uint16_t ordinal, pe_export& result) const noexcept
+    {
+        if (!has_exports_ || (ordinal < exports_.Base))
+            return false;
+
+        return make_export(ordinal - exports_.Base, nullptr, result);
+    }
+
+    inline pointer pe_image::find_export(const char* name) const noexcept
+    {
+        pe_export result;
+
+        if (!find_export(name, result) || result.forwarder || !result.rva)
+            return nullptr;
+
+        return rva_to_pointer(result.rva);
+    }
+} // namespace mem
+
+#endif // MEM_PE_IMAGE_BRICK_H
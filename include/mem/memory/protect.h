@@ -24,7 +24,10 @@
 #include <mem/memory/prot_flags.h>
 #include <mem/memory/region.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
+#include <vector>
 
 namespace mem
 {
@@ -33,6 +36,10 @@ namespace mem
     void* protect_alloc(std::size_t length, prot_flags flags, data_accessor& accessor = get_default_accessor());
     void protect_free(void* memory, std::size_t length, data_accessor& accessor = get_default_accessor());
 
+    // Fails instead of replacing anything already mapped at memory
+    void* protect_alloc_at(
+        void* memory, std::size_t length, prot_flags flags, data_accessor& accessor = get_default_accessor());
+
     prot_flags protect_query(void* memory, data_accessor& accessor = get_default_accessor());
 
     bool protect_modify(void* memory, std::size_t length, prot_flags flags, prot_flags* old_flags = nullptr,
@@ -41,9 +48,9 @@ namespace mem
     class protect : public region
     {
     private:
+        data_accessor* accessor_ {nullptr};
         prot_flags old_flags_ {prot_flags::INVALID};
         bool success_ {false};
-        data_accessor* accessor_ {nullptr};
 
     public:
         protect(region range, data_accessor& accessor = get_default_accessor(), prot_flags flags = prot_flags::RWX);
@@ -56,6 +63,56 @@ namespace mem
         prot_flags release() noexcept;
     };
 
+    // Changes the protection of many ranges together, and restores them when destroyed.
+    //
+    // Ranges are rounded out to whole pages and merged, and their old protection is taken from a single
+    // query_regions call, so each merged range costs one protection change to apply and one to restore.
+    class protect_batch
+    {
+    private:
+        struct range
+        {
+            std::uintptr_t start;
+            std::uintptr_t end;
+            prot_flags flags;
+        };
+
+        data_accessor* accessor_ {nullptr};
+        prot_flags flags_ {prot_flags::RWX};
+        bool success_ {true};
+
+        std::vector<range> pending_ {};
+        std::vector<range> applied_ {}; // In the order they were changed, with their old protection
+
+        bool modify(const range* first, const range* last, prot_flags flags, bool record);
+
+    public:
+        explicit protect_batch(data_accessor& accessor = get_default_accessor(), prot_flags flags = prot_flags::RWX);
+        ~protect_batch();
+
+        protect_batch(protect_batch&& rhs) noexcept;
+        protect_batch(const protect_batch&) = delete;
+        protect_batch& operator=(const protect_batch&) = delete;
+
+        void add(region range);
+
+        // Changes the protection of everything added since the last apply.
+        // Returns false if any part of it could not be changed, or is not mapped.
+        bool apply();
+
+        // Restores everything applied so far, most recent first
+        bool restore();
+
+        // Keeps the new protection, forgetting what to restore
+        void release() noexcept;
+
+        // Number of ranges waiting to be restored, split wherever their old protection differed
+        std::size_t size() const noexcept;
+
+        // Whether every apply succeeded
+        explicit operator bool() const noexcept;
+    };
+
     inline std::size_t page_size()
     {
 #if defined(_WIN32)
@@ -77,6 +134,11 @@ namespace mem
         return accessor.protect_free(memory, length);
     }
 
+    inline void* protect_alloc_at(void* memory, std::size_t length, prot_flags flags, data_accessor& accessor)
+    {
+        return accessor.protect_alloc_at(memory, length, flags);
+    }
+
     inline prot_flags protect_query(void* memory, data_accessor& accessor)
     {
         return accessor.protect_query(memory);
@@ -124,6 +186,187 @@ namespace mem
 
         return old_flags_;
     }
+
+    inline protect_batch::protect_batch(data_accessor& accessor, prot_flags flags)
+        : accessor_(&accessor)
+        , flags_(flags)
+    {}
+
+    inline protect_batch::~protect_batch()
+    {
+        restore();
+    }
+
+    inline protect_batch::protect_batch(protect_batch&& rhs) noexcept
+        : accessor_(rhs.accessor_)
+        , flags_(rhs.flags_)
+        , success_(rhs.success_)
+        , pending_(std::move(rhs.pending_))
+        , applied_(std::move(rhs.applied_))
+    {
+        rhs.pending_.clear();
+        rhs.applied_.clear();
+    }
+
+    inline void protect_batch::add(region range)
+    {
+        if (!range.size)
+            return;
+
+        const std::uintptr_t page = page_size();
+        const std::uintptr_t start = range.start.as<std::uintptr_t>();
+
+        pending_.push_back({start & ~(page - 1), (start + range.size + page - 1) & ~(page - 1), flags_});
+    }
+
+    inline bool protect_batch::modify(const range* first, const range* last, prot_flags flags, bool record)
+    {
+        // Pieces with different protection may still belong to separate allocations, which Windows changes one
+        // at a time
+        if (!accessor_->protect_modify(reinterpret_cast<void*>(first->start), (last - 1)->end - first->start,
+                flags, nullptr))
+        {
+            if (last - first == 1)
+                return false;
+
+            bool success = true;
+
+            for (; first != last; ++first)
+            {
+                const bool changed = accessor_->protect_modify(
+                    reinterpret_cast<void*>(first->start), first->end - first->start, flags, nullptr);
+
+                if (changed && record)
+                    applied_.push_back(*first);
+
+                success &= changed;
+            }
+
+            return success;
+        }
+
+        if (record)
+            applied_.insert(applied_.end(), first, last);
+
+        return true;
+    }
+
+    inline bool protect_batch::apply()
+    {
+        if (pending_.empty())
+            return true;
+
+        std::sort(pending_.begin(), pending_.end(), [](const range& lhs, const range& rhs) {
+            return lhs.start < rhs.start;
+        });
+
+        std::vector<range> merged;
+
+        for (const range& value : pending_)
+        {
+            if (!merged.empty() && (value.start <= merged.back().end))
+                merged.back().end = (std::max)(merged.back().end, value.end);
+            else
+                merged.push_back(value);
+        }
+
+        pending_.clear();
+
+        // The old protection of everything at once, instead of one query per range
+        std::vector<region_info> snapshot;
+
+        bool success = accessor_->query_regions(
+            reinterpret_cast<void*>(merged.front().start), merged.back().end - merged.front().start, snapshot);
+
+        std::vector<range> pieces;
+        std::size_t next = 0;
+
+        for (const range& value : merged)
+        {
+            pieces.clear();
+
+            for (; next < snapshot.size(); ++next)
+            {
+                const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(snapshot[next].start);
+                const std::uintptr_t end = start + snapshot[next].size;
+
+                if (start >= value.end)
+                    break;
+
+                if (end > value.start)
+                {
+                    pieces.push_back(
+                        {(std::max)(start, value.start), (std::min)(end, value.end), snapshot[next].flags});
+                }
+
+                // Shared with the next range
+                if (end > value.end)
+                    break;
+            }
+
+            // One change per contiguous run of mapped pieces
+            std::uintptr_t covered = value.start;
+
+            for (std::size_t i = 0; i < pieces.size();)
+            {
+                std::size_t j = i + 1;
+
+                while ((j < pieces.size()) && (pieces[j].start == pieces[j - 1].end))
+                    ++j;
+
+                // Anything not mapped is left out, but still fails the apply
+                success &= (pieces[i].start == covered);
+                success &= modify(&pieces[i], &pieces[i] + (j - i), flags_, true);
+
+                covered = pieces[j - 1].end;
+                i = j;
+            }
+
+            success &= (covered == value.end);
+        }
+
+        success_ &= success;
+
+        return success;
+    }
+
+    inline bool protect_batch::restore()
+    {
+        bool success = true;
+
+        // Backwards, so ranges applied twice end up with the protection they had before the first apply
+        for (std::size_t i = applied_.size(); i;)
+        {
+            std::size_t j = i - 1;
+
+            // Neighbours which get the same protection back are restored together
+            while (j && (applied_[j - 1].end == applied_[j].start) && (applied_[j - 1].flags == applied_[j].flags))
+                --j;
+
+            success &= modify(&applied_[j], &applied_[j] + (i - j), applied_[j].flags, false);
+
+            i = j;
+        }
+
+        applied_.clear();
+
+        return success;
+    }
+
+    MEM_STRONG_INLINE void protect_batch::release() noexcept
+    {
+        applied_.clear();
+    }
+
+    MEM_STRONG_INLINE std::size_t protect_batch::size() const noexcept
+    {
+        return applied_.size();
+    }
+
+    MEM_STRONG_INLINE protect_batch::operator bool() const noexcept
+    {
+        return success_;
+    }
 } // namespace mem
 
 #endif // MEM_PROTECT_BRICK_H
@@ -0,0 +1,380 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_REGION_SET_BRICK_H
+#define MEM_REGION_SET_BRICK_H
+
+#include <mem/memory/region.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+namespace mem
+{
+    // A set of addresses, stored as sorted, non-overlapping and non-adjacent regions.
+    // Only addresses are tracked, the flags of inserted regions are dropped.
+    class region_set
+    {
+    private:
+        std::vector<region> regions_ {};
+
+        static std::uintptr_t begin_of(const region& range) noexcept;
+        static std::uintptr_t end_of(const region& range) noexcept;
+        static region make(std::uintptr_t begin, std::uintptr_t end) noexcept;
+
+        // Appends to a sorted vector, merging with the last region if they touch
+        static void append(std::vector<region>& regions, std::uintptr_t begin, std::uintptr_t end);
+
+    public:
+        using iterator = std::vector<region>::const_iterator;
+
+        region_set() = default;
+
+        explicit region_set(region range);
+        region_set(std::initializer_list<region> ranges);
+
+        void insert(region range);
+        void erase(region range);
+        void clear() noexcept;
+
+        // The region containing address, or nullptr
+        const region* find(pointer address) const noexcept;
+
+        bool contains(pointer address) const noexcept;
+        bool contains(region range) const noexcept;
+        bool intersects(region range) const noexcept;
+
+        bool empty() const noexcept;
+
+        // Number of disjoint regions
+        std::size_t size() const noexcept;
+
+        // Number of bytes covered
+        std::size_t total_size() const noexcept;
+
+        iterator begin() const noexcept;
+        iterator end() const noexcept;
+
+        const region& operator[](std::size_t index) const noexcept;
+
+        region_set& operator|=(const region_set& rhs);
+        region_set& operator&=(const region_set& rhs);
+        region_set& operator-=(const region_set& rhs);
+
+        bool operator==(const region_set& rhs) const noexcept;
+        bool operator!=(const region_set& rhs) const noexcept;
+    };
+
+    region_set operator|(region_set lhs, const region_set& rhs);
+    region_set operator&(region_set lhs, const region_set& rhs);
+    region_set operator-(region_set lhs, const region_set& rhs);
+
+    MEM_STRONG_INLINE std::uintptr_t region_set::begin_of(const region& range) noexcept
+    {
+        return range.start.as<std::uintptr_t>();
+    }
+
+    MEM_STRONG_INLINE std::uintptr_t region_set::end_of(const region& range) noexcept
+    {
+        return range.start.as<std::uintptr_t>() + range.size;
+    }
+
+    MEM_STRONG_INLINE region region_set::make(std::uintptr_t begin, std::uintptr_t end) noexcept
+    {
+        return region(begin, end - begin);
+    }
+
+    MEM_STRONG_INLINE void region_set::append(std::vector<region>& regions, std::uintptr_t begin, std::uintptr_t end)
+    {
+        if (begin >= end)
+            return;
+
+        if (!regions.empty() && (begin <= end_of(regions.back())))
+        {
+            region& last = regions.back();
+
+            if (end > end_of(last))
+                last.size = end - begin_of(last);
+        }
+        else
+        {
+            regions.push_back(make(begin, end));
+        }
+    }
+
+    inline region_set::region_set(region range)
+    {
+        insert(range);
+    }
+
+    inline region_set::region_set(std::initializer_list<region> ranges)
+    {
+        for (const region& range : ranges)
+            insert(range);
+    }
+
+    inline void region_set::insert(region range)
+    {
+        if (!range.size)
+            return;
+
+        std::uintptr_t begin = begin_of(range);
+        std::uintptr_t end = end_of(range);
+
+        // First region which touches or follows the new one
+        auto first = std::lower_bound(regions_.begin(), regions_.end(), begin,
+            [](const region& lhs, std::uintptr_t rhs) { return end_of(lhs) < rhs; });
+
+        // First region entirely after the new one
+        auto last = std::upper_bound(
+            first, regions_.end(), end, [](std::uintptr_t lhs, const region& rhs) { return lhs < begin_of(rhs); });
+
+        if (first != last)
+        {
+            begin = (std::min)(begin, begin_of(*first));
+            end = (std::max)(end, end_of(*(last - 1)));
+
+            *first = make(begin, end);
+            regions_.erase(first + 1, last);
+        }
+        else
+        {
+            regions_.insert(first, make(begin, end));
+        }
+    }
+
+    inline void region_set::erase(region range)
+    {
+        if (!range.size)
+            return;
+
+        const std::uintptr_t begin = begin_of(range);
+        const std::uintptr_t end = end_of(range);
+
+        // First region which overlaps or follows the erased one
+        auto first = std::upper_bound(regions_.begin(), regions_.end(), begin,
+            [](std::uintptr_t lhs, const region& rhs) { return lhs < end_of(rhs); });
+
+        // First region entirely after the erased one
+        auto last = std::lower_bound(
+            first, regions_.end(), end, [](const region& lhs, std::uintptr_t rhs) { return begin_of(lhs) < rhs; });
+
+        if (first == last)
+            return;
+
+        const std::uintptr_t head = begin_of(*first);
+        const std::uintptr_t tail = end_of(*(last - 1));
+
+        first = regions_.erase(first, last);
+
+        if (end < tail)
+            first = regions_.insert(first, make(end, tail));
+
+        if (head < begin)
+            regions_.insert(first, make(head, begin));
+    }
+
+    MEM_STRONG_INLINE void region_set::clear() noexcept
+    {
+        regions_.clear();
+    }
+
+    inline const region* region_set::find(pointer address) const noexcept
+    {
+        const std::uintptr_t value = address.as<std::uintptr_t>();
+
+        auto iter = std::upper_bound(regions_.begin(), regions_.end(), value,
+            [](std::uintptr_t lhs, const region& rhs) { return lhs < end_of(rhs); });
+
+        if ((iter != regions_.end()) && (begin_of(*iter) <= value))
+            return &*iter;
+
+        return nullptr;
+    }
+
+    MEM_STRONG_INLINE bool region_set::contains(pointer address) const noexcept
+    {
+        return find(address) != nullptr;
+    }
+
+    inline bool region_set::contains(region range) const noexcept
+    {
+        if (!range.size)
+            return true;
+
+        const region* found = find(range.start);
+
+        return found && found->contains(range);
+    }
+
+    inline bool region_set::intersects(region range) const noexcept
+    {
+        if (!range.size)
+            return false;
+
+        auto iter = std::upper_bound(regions_.begin(), regions_.end(), begin_of(range),
+            [](std::uintptr_t lhs, const region& rhs) { return lhs < end_of(rhs); });
+
+        return (iter != regions_.end()) && (begin_of(*iter) < end_of(range));
+    }
+
+    MEM_STRONG_INLINE bool region_set::empty() const noexcept
+    {
+        return regions_.empty();
+    }
+
+    MEM_STRONG_INLINE std::size_t region_set::size() const noexcept
+    {
+        return regions_.size();
+    }
+
+    inline std::size_t region_set::total_size() const noexcept
+    {
+        std::size_t total = 0;
+
+        for (const region& range : regions_)
+            total += range.size;
+
+        return total;
+    }
+
+    MEM_STRONG_INLINE region_set::iterator region_set::begin() const noexcept
+    {
+        return regions_.begin();
+    }
+
+    MEM_STRONG_INLINE region_set::iterator region_set::end() const noexcept
+    {
+        return regions_.end();
+    }
+
+    MEM_STRONG_INLINE const region& region_set::operator[](std::size_t index) const noexcept
+    {
+        return regions_[index];
+    }
+
+    inline region_set& region_set::operator|=(const region_set& rhs)
+    {
+        std::vector<region> result;
+        result.reserve(regions_.size() + rhs.regions_.size());
+
+        auto i = regions_.begin();
+        auto j = rhs.regions_.begin();
+
+        while ((i != regions_.end()) || (j != rhs.regions_.end()))
+        {
+            const region& next =
+                ((j == rhs.regions_.end()) || ((i != regions_.end()) && (begin_of(*i) < begin_of(*j)))) ? *i++ : *j++;
+
+            append(result, begin_of(next), end_of(next));
+        }
+
+        regions_.swap(result);
+
+        return *this;
+    }
+
+    inline region_set& region_set::operator&=(const region_set& rhs)
+    {
+        std::vector<region> result;
+
+        auto i = regions_.begin();
+        auto j = rhs.regions_.begin();
+
+        while ((i != regions_.end()) && (j != rhs.regions_.end()))
+        {
+            const std::uintptr_t begin = (std::max)(begin_of(*i), begin_of(*j));
+            const std::uintptr_t end = (std::min)(end_of(*i), end_of(*j));
+
+            if (begin < end)
+                result.push_back(make(begin, end));
+
+            if (end_of(*i) < end_of(*j))
+                ++i;
+            else
+                ++j;
+        }
+
+        regions_.swap(result);
+
+        return *this;
+    }
+
+    inline region_set& region_set::operator-=(const region_set& rhs)
+    {
+        std::vector<region> result;
+        result.reserve(regions_.size());
+
+        auto j = rhs.regions_.begin();
+
+        for (const region& range : regions_)
+        {
+            std::uintptr_t begin = begin_of(range);
+            const std::uintptr_t end = end_of(range);
+
+            while ((j != rhs.regions_.end()) && (end_of(*j) <= begin))
+                ++j;
+
+            for (auto k = j; (k != rhs.regions_.end()) && (begin_of(*k) < end); ++k)
+            {
+                if (begin < begin_of(*k))
+                    result.push_back(make(begin, begin_of(*k)));
+
+                begin = (std::max)(begin, end_of(*k));
+            }
+
+            if (begin < end)
+                result.push_back(make(begin, end));
+        }
+
+        regions_.swap(result);
+
+        return *this;
+    }
+
+    inline bool region_set::operator==(const region_set& rhs) const noexcept
+    {
+        return (regions_.size() == rhs.regions_.size()) &&
+            std::equal(regions_.begin(), regions_.end(), rhs.regions_.begin(),
+                [](const region& lhs, const region& rhs_) { return (lhs.start == rhs_.start) && (lhs.size == rhs_.size); });
+    }
+
+    MEM_STRONG_INLINE bool region_set::operator!=(const region_set& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    MEM_STRONG_INLINE region_set operator|(region_set lhs, const region_set& rhs)
+    {
+        return lhs |= rhs;
+    }
+
+    MEM_STRONG_INLINE region_set operator&(region_set lhs, const region_set& rhs)
+    {
+        return lhs &= rhs;
+    }
+
+    MEM_STRONG_INLINE region_set operator-(region_set lhs, const region_set& rhs)
+    {
+        return lhs -= rhs;
+    }
+} // namespace mem
+
+#endif // MEM_REGION_SET_BRICK_H
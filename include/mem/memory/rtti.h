@@ -21,16 +21,16 @@
 #define MEM_RTTI_BRICK_H
 
 #include <mem/memory/mem.h>
+#include <mem/memory/msvc_rtti.h>
 
-#if defined(MEM_ARCH_X86) || defined(MEM_ARCH_X86_64)
-#    if !defined(_WIN32)
-#        error mem::rtti only supports windows
-#    endif // !_WIN32
+#if !defined(_WIN32)
+#    include <mem/memory/itanium_rtti.h>
 #else
-#    error mem::rtti only supports x86 and x64
-#endif
+#    if !defined(MEM_ARCH_X86) && !defined(MEM_ARCH_X86_64)
+#        error mem::rtti only supports x86 and x64
+#    endif
 
-#include <functional>
+#    include <functional>
 
 namespace mem
 {
@@ -299,4 +299,5 @@ namespace mem
 #endif // MEM_RTTI_DEMANGLE
     } // namespace rtti
 } // namespace mem
+#endif // _WIN32
 #endif // !MEM_RTTI_BRICK_H
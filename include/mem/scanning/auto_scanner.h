@@ -0,0 +1,352 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_AUTO_SCANNER_BRICK_H
+#define MEM_AUTO_SCANNER_BRICK_H
+
+#include <mem/scanning/boyer_moore_scanner.h>
+#include <mem/scanning/pattern.h>
+#include <mem/scanning/simd_scanner.h>
+
+#include <chrono>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mem
+{
+    enum class scan_engine
+    {
+        none,
+        simd,
+        boyer_moore,
+    };
+
+    const char* engine_name(scan_engine engine) noexcept;
+
+    struct auto_scanner_thresholds
+    {
+        // Anchors at or below this frequency rank are rare enough for find_byte to beat any skip table
+        std::size_t rare_anchor_rank {0xF0};
+
+        // Shortest Boyer-Moore shift worth the table lookup per step
+        std::size_t min_bm_skip {8};
+
+        // Regions smaller than this are not worth the skip loop setup
+        std::size_t min_bm_region {0x1000};
+    };
+
+    class auto_scanner : public scanner_base<auto_scanner>
+    {
+    private:
+        simd_scanner simd_ {};
+        boyer_moore_scanner bm_ {};
+
+        auto_scanner_thresholds thresholds_ {};
+
+        std::size_t anchor_rank_ {SIZE_MAX};
+
+        struct shared_thresholds
+        {
+            std::mutex lock {};
+            auto_scanner_thresholds value {};
+        };
+
+        static shared_thresholds& default_thresholds() noexcept;
+
+        static void calibration_sample(std::vector<byte>& data, std::size_t size);
+        static double time_scan(const auto_scanner& scanner, region range, scan_engine engine);
+
+    public:
+        auto_scanner() = default;
+
+        auto_scanner(pattern_view pattern);
+        auto_scanner(pattern_view pattern, const auto_scanner_thresholds& thresholds);
+
+        // Combines scanners built earlier for the same pattern
+        auto_scanner(const simd_scanner& simd, const boyer_moore_scanner& boyer_moore);
+        auto_scanner(
+            const simd_scanner& simd, const boyer_moore_scanner& boyer_moore, const auto_scanner_thresholds& thresholds);
+
+        pointer scan(region range) const;
+
+        using scanner_base<auto_scanner>::scan_all;
+
+        template <typename Func>
+        pointer scan_all(region range, Func func) const;
+
+        // The engine used for a region of the given size
+        scan_engine select(std::size_t region_size) const noexcept;
+
+        // The engine used for large regions
+        scan_engine engine() const noexcept;
+
+        const simd_scanner& simd() const noexcept;
+        const boyer_moore_scanner& boyer_moore() const noexcept;
+
+        // Thresholds used by newly constructed scanners
+        static auto_scanner_thresholds thresholds();
+
+        // Replaces thresholds(). Scanners constructed earlier, or on other threads meanwhile, keep what they had.
+        static void set_thresholds(const auto_scanner_thresholds& value);
+
+        // Measures both engines on the sample (or on synthetic data if it is too small), and returns thresholds()
+        // tuned to it. Nothing is installed, so pass the result to set_thresholds to make it the default.
+        static auto_scanner_thresholds calibrate(region sample = {});
+    };
+
+    MEM_STRONG_INLINE const char* engine_name(scan_engine engine) noexcept
+    {
+        switch (engine)
+        {
+            case scan_engine::simd: return "simd";
+            case scan_engine::boyer_moore: return "boyer_moore";
+            case scan_engine::none: break;
+        }
+
+        return "none";
+    }
+
+    inline auto_scanner::auto_scanner(pattern_view _pattern)
+        : auto_scanner(_pattern, thresholds())
+    {}
+
+    inline auto_scanner::auto_scanner(pattern_view _pattern, const auto_scanner_thresholds& _thresholds)
+        : scanner_base<auto_scanner>(_pattern)
+        , simd_(_pattern)
+        , bm_(_pattern)
+        , thresholds_(_thresholds)
+    {
+        const std::size_t skip_pos = simd_.skip_pos();
+
+        if (skip_pos != SIZE_MAX)
+            anchor_rank_ = simd_scanner::default_frequencies()[_pattern.bytes()[skip_pos]];
+    }
+
+    inline auto_scanner::auto_scanner(const simd_scanner& simd, const boyer_moore_scanner& boyer_moore)
+        : auto_scanner(simd, boyer_moore, thresholds())
+    {}
+
+    inline auto_scanner::auto_scanner(
+        const simd_scanner& simd, const boyer_moore_scanner& boyer_moore, const auto_scanner_thresholds& _thresholds)
+        : scanner_base<auto_scanner>(simd.get_pattern())
+        , simd_(simd)
+        , bm_(boyer_moore)
+        , thresholds_(_thresholds)
+    {
+        const std::size_t skip_pos = simd_.skip_pos();
+
+        if (skip_pos != SIZE_MAX)
+            anchor_rank_ = simd_scanner::default_frequencies()[pattern_.bytes()[skip_pos]];
+    }
+
+    inline scan_engine auto_scanner::select(std::size_t region_size) const noexcept
+    {
+        if (!pattern_ || !pattern_.trimmed_size())
+            return scan_engine::none;
+
+        const std::size_t bm_skip = bm_.max_skip();
+
+        // Without a shift table Boyer-Moore is a naive loop
+        if (!bm_skip)
+            return scan_engine::simd;
+
+        // Without a solid anchor byte the SIMD scanner is a naive loop
+        if (anchor_rank_ == SIZE_MAX)
+            return scan_engine::boyer_moore;
+
+        if (region_size < thresholds_.min_bm_region)
+            return scan_engine::simd;
+
+        if (anchor_rank_ <= thresholds_.rare_anchor_rank)
+            return scan_engine::simd;
+
+        return (bm_skip >= thresholds_.min_bm_skip) ? scan_engine::boyer_moore : scan_engine::simd;
+    }
+
+    MEM_STRONG_INLINE scan_engine auto_scanner::engine() const noexcept
+    {
+        return select(SIZE_MAX);
+    }
+
+    MEM_STRONG_INLINE const simd_scanner& auto_scanner::simd() const noexcept
+    {
+        return simd_;
+    }
+
+    MEM_STRONG_INLINE const boyer_moore_scanner& auto_scanner::boyer_moore() const noexcept
+    {
+        return bm_;
+    }
+
+    MEM_STRONG_INLINE pointer auto_scanner::scan(region range) const
+    {
+        switch (select(range.size))
+        {
+            case scan_engine::simd: return simd_.scan(range);
+            case scan_engine::boyer_moore: return bm_.scan(range);
+            case scan_engine::none: break;
+        }
+
+        return nullptr;
+    }
+
+    template <typename Func>
+    MEM_STRONG_INLINE pointer auto_scanner::scan_all(region range, Func func) const
+    {
+        switch (select(range.size))
+        {
+            case scan_engine::simd: return simd_.scan_all(range, std::move(func));
+            case scan_engine::boyer_moore: return bm_.scan_all(range, std::move(func));
+            case scan_engine::none: break;
+        }
+
+        return nullptr;
+    }
+
+    inline auto_scanner::shared_thresholds& auto_scanner::default_thresholds() noexcept
+    {
+        static shared_thresholds instance;
+        return instance;
+    }
+
+    inline auto_scanner_thresholds auto_scanner::thresholds()
+    {
+        shared_thresholds& shared = default_thresholds();
+
+        std::lock_guard<std::mutex> guard(shared.lock);
+
+        return shared.value;
+    }
+
+    inline void auto_scanner::set_thresholds(const auto_scanner_thresholds& value)
+    {
+        shared_thresholds& shared = default_thresholds();
+
+        std::lock_guard<std::mutex> guard(shared.lock);
+
+        shared.value = value;
+    }
+
+    inline void auto_scanner::calibration_sample(std::vector<byte>& data, std::size_t size)
+    {
+        // Skew the byte distribution the same way as default_frequencies, so common bytes really are common
+        const byte* const frequencies = simd_scanner::default_frequencies();
+
+        std::uint32_t weights[256];
+        std::uint32_t total = 0;
+
+        for (std::size_t i = 0; i < 256; ++i)
+        {
+            const std::uint32_t rank = frequencies[i] + 1u;
+            total += weights[i] = rank * rank * rank / 256;
+        }
+
+        std::uint32_t state = 0x9E3779B9;
+
+        data.resize(size);
+
+        for (byte& value : data)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            std::uint32_t pick = state % total;
+            std::size_t i = 0;
+
+            while (pick >= weights[i])
+                pick -= weights[i++];
+
+            value = static_cast<byte>(i);
+        }
+    }
+
+    inline double auto_scanner::time_scan(const auto_scanner& scanner, region range, scan_engine engine)
+    {
+        double best = 0.0;
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            std::size_t hits = 0;
+
+            const auto count = [&hits](pointer) {
+                ++hits;
+                return false;
+            };
+
+            if (engine == scan_engine::simd)
+                scanner.simd_.scan_all(range, count);
+            else
+                scanner.bm_.scan_all(range, count);
+
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            if (i == 0 || elapsed.count() < best)
+                best = elapsed.count();
+        }
+
+        return best;
+    }
+
+    inline auto_scanner_thresholds auto_scanner::calibrate(region sample)
+    {
+        auto_scanner_thresholds result = thresholds();
+
+        std::vector<byte> synthetic;
+
+        if (sample.size < 0x40000)
+        {
+            calibration_sample(synthetic, 0x100000);
+            sample = region(synthetic.data(), synthetic.size());
+        }
+
+        const byte* const frequencies = simd_scanner::default_frequencies();
+
+        byte by_rank[256];
+
+        for (std::size_t i = 0; i < 256; ++i)
+            by_rank[frequencies[i]] = static_cast<byte>(i);
+
+        const std::size_t probe_size = result.min_bm_skip;
+
+        // Walk up from rare anchors until the skip table wins, probing with solid patterns just long enough
+        // to reach min_bm_skip so only the anchor rank differs between probes.
+        std::size_t rare_rank = 0;
+
+        for (std::size_t rank = 0x10; rank + probe_size <= 0x100; rank += 0x10)
+        {
+            const pattern probe(&by_rank[rank], nullptr, probe_size);
+            const auto_scanner scanner(probe, result);
+
+            if (time_scan(scanner, sample, scan_engine::boyer_moore) < time_scan(scanner, sample, scan_engine::simd))
+                break;
+
+            rare_rank = rank;
+        }
+
+        result.rare_anchor_rank = rare_rank;
+
+        return result;
+    }
+} // namespace mem
+
+#endif // MEM_AUTO_SCANNER_BRICK_H
@@ -22,57 +22,134 @@
 
 #include <mem/scanning/pattern.h>
 
+#include <algorithm>
+
 namespace mem
 {
+    static constexpr const std::size_t default_min_bc_skip {5};
+    static constexpr const std::size_t default_min_gs_skip {25};
+    static constexpr const std::size_t default_min_qgram_skip {3};
+
+    // The precomputed state of a boyer_moore_scanner, which can live outside of it
+    struct boyer_moore_tables
+    {
+        const std::uint8_t* bc_skips {nullptr};    // 256 entries
+        const std::uint16_t* gs_skips {nullptr};   // One entry per byte of the trimmed pattern
+        const std::uint8_t* qgram_skips {nullptr}; // boyer_moore_scanner::qgram_table_size entries
+        std::size_t qgram_size {0};
+
+        std::size_t skip_pos {SIZE_MAX};
+        std::size_t max_skip {0};
+    };
+
     class boyer_moore_scanner : public scanner_base<boyer_moore_scanner>
     {
+    public:
+        static constexpr const std::size_t qgram_table_bits {12};
+        static constexpr const std::size_t qgram_table_size {std::size_t(1) << qgram_table_bits};
+
     private:
         // Boyer–Moore + Boyer–Moore–Horspool Implementation
-        std::vector<std::size_t> bc_skips_ {};
-        std::vector<std::size_t> gs_skips_ {};
+        std::vector<std::uint8_t> bc_skips_ {};
+        std::vector<std::uint16_t> gs_skips_ {};
+
+        // Wu–Manber style q-gram shifts, used for masked patterns without a usable solid run
+        std::vector<std::uint8_t> qgram_skips_ {};
+        std::size_t qgram_size_ {0};
 
         std::size_t skip_pos_ {SIZE_MAX};
+        std::size_t max_skip_ {0};
+
+        // Tables owned elsewhere, only used while the vectors above are empty
+        const std::uint8_t* bc_table_ {nullptr};
+        const std::uint16_t* gs_table_ {nullptr};
+        const std::uint8_t* qgram_table_ {nullptr};
+
+        const std::uint8_t* bc_table() const noexcept;
+        const std::uint16_t* gs_table() const noexcept;
+        const std::uint8_t* qgram_table() const noexcept;
+
+        template <std::size_t Q>
+        static std::size_t qgram_hash(const byte* values) noexcept;
 
         std::size_t get_longest_run(std::size_t& length) const;
 
+        std::size_t get_qgram_skip(std::size_t q) const;
+        void build_qgram_skips(std::size_t q, std::size_t max_skip);
+
         bool is_prefix(std::size_t pos) const;
         std::size_t get_suffix_length(std::size_t pos) const;
 
+        template <std::size_t Q, typename Func>
+        pointer scan_qgrams(const byte* current, const byte* end, Func& func) const;
+
     public:
         boyer_moore_scanner() = default;
 
-        boyer_moore_scanner(const pattern& pattern);
-        boyer_moore_scanner(const pattern& pattern, std::size_t min_bc_skip, std::size_t min_gs_skip);
+        boyer_moore_scanner(pattern_view pattern);
+        boyer_moore_scanner(pattern_view pattern, std::size_t min_bc_skip, std::size_t min_gs_skip,
+            std::size_t min_qgram_skip = default_min_qgram_skip);
+
+        // Uses tables built earlier for the same pattern, which must outlive the scanner
+        boyer_moore_scanner(pattern_view pattern, const boyer_moore_tables& tables) noexcept;
 
         pointer scan(region range) const;
-    };
 
-    static constexpr const std::size_t default_min_bc_skip {5};
-    static constexpr const std::size_t default_min_gs_skip {25};
+        using scanner_base<boyer_moore_scanner>::scan_all;
+
+        template <typename Func>
+        pointer scan_all(region range, Func func) const;
+
+        std::size_t max_skip() const noexcept;
+
+        boyer_moore_tables tables() const noexcept;
+    };
 
-    inline boyer_moore_scanner::boyer_moore_scanner(const pattern& _pattern)
-        : boyer_moore_scanner(_pattern, default_min_bc_skip, default_min_gs_skip)
+    inline boyer_moore_scanner::boyer_moore_scanner(pattern_view _pattern)
+        : boyer_moore_scanner(_pattern, default_min_bc_skip, default_min_gs_skip, default_min_qgram_skip)
     {}
 
     inline boyer_moore_scanner::boyer_moore_scanner(
-        const pattern& _pattern, std::size_t min_bc_skip, std::size_t min_gs_skip)
+        pattern_view _pattern, std::size_t min_bc_skip, std::size_t min_gs_skip, std::size_t min_qgram_skip)
         : scanner_base<boyer_moore_scanner>(_pattern)
     {
         std::size_t max_skip = 0;
         std::size_t skip_pos = get_longest_run(max_skip);
 
-        const byte* const bytes = pattern_->bytes();
-        const std::size_t trimmed_size = pattern_->trimmed_size();
+        const byte* const bytes = pattern_.bytes();
+        const std::size_t trimmed_size = pattern_.trimmed_size();
+
+        if (pattern_.needs_masks() && (min_qgram_skip > 0))
+        {
+            const std::size_t qgram_skip_2 = get_qgram_skip(2);
+            const std::size_t qgram_skip_3 = get_qgram_skip(3);
+
+            // 3-grams are more selective on skewed inputs, but only worth it for long windows
+            const std::size_t q = ((qgram_skip_3 >= 16) && (qgram_skip_3 + 1 >= qgram_skip_2)) ? 3 : 2;
+            const std::size_t qgram_skip = (q == 3) ? qgram_skip_3 : qgram_skip_2;
+
+            if ((qgram_skip >= min_qgram_skip) && (qgram_skip >= max_skip || max_skip < min_bc_skip))
+            {
+                build_qgram_skips(q, qgram_skip);
+                max_skip_ = qgram_skip;
+
+                return;
+            }
+        }
 
         if ((min_bc_skip > 0) && (max_skip >= min_bc_skip))
         {
-            bc_skips_.resize(256, max_skip);
+            const std::uint8_t max_bc_skip = static_cast<std::uint8_t>((std::min)(max_skip, std::size_t(UINT8_MAX)));
+
+            bc_skips_.resize(256, max_bc_skip);
             skip_pos_ = skip_pos + max_skip - 1;
+            max_skip_ = max_bc_skip;
 
             for (std::size_t i = skip_pos, last = skip_pos + max_skip - 1; i < last; ++i)
-                bc_skips_[bytes[i]] = last - i;
+                bc_skips_[bytes[i]] = static_cast<std::uint8_t>((std::min)(last - i, std::size_t(UINT8_MAX)));
 
-            if ((skip_pos == 0) && (max_skip == trimmed_size) && (min_gs_skip > 0) && (max_skip >= min_gs_skip))
+            if ((skip_pos == 0) && (max_skip == trimmed_size) && (min_gs_skip > 0) && (max_skip >= min_gs_skip) &&
+                (trimmed_size <= (UINT16_MAX / 2)))
             {
                 gs_skips_.resize(trimmed_size);
 
@@ -85,7 +162,7 @@ namespace mem
                     if (is_prefix(i + 1))
                         last_prefix = i + 1;
 
-                    gs_skips_[i] = last_prefix + (last - i);
+                    gs_skips_[i] = static_cast<std::uint16_t>(last_prefix + (last - i));
                 }
 
                 for (std::size_t i = 0; i < last; ++i)
@@ -94,7 +171,7 @@ namespace mem
                     std::size_t pos = last - suffix_length;
 
                     if (bytes[i - suffix_length] != bytes[pos])
-                        gs_skips_[pos] = suffix_length + (last - i);
+                        gs_skips_[pos] = static_cast<std::uint16_t>(suffix_length + (last - i));
                 }
             }
             else
@@ -104,6 +181,31 @@ namespace mem
         }
     }
 
+    inline boyer_moore_scanner::boyer_moore_scanner(pattern_view _pattern, const boyer_moore_tables& tables) noexcept
+        : scanner_base<boyer_moore_scanner>(_pattern)
+        , qgram_size_(tables.qgram_size)
+        , skip_pos_(tables.skip_pos)
+        , max_skip_(tables.max_skip)
+        , bc_table_(tables.bc_skips)
+        , gs_table_(tables.gs_skips)
+        , qgram_table_(tables.qgram_skips)
+    {}
+
+    MEM_STRONG_INLINE const std::uint8_t* boyer_moore_scanner::bc_table() const noexcept
+    {
+        return !bc_skips_.empty() ? bc_skips_.data() : bc_table_;
+    }
+
+    MEM_STRONG_INLINE const std::uint16_t* boyer_moore_scanner::gs_table() const noexcept
+    {
+        return !gs_skips_.empty() ? gs_skips_.data() : gs_table_;
+    }
+
+    MEM_STRONG_INLINE const std::uint8_t* boyer_moore_scanner::qgram_table() const noexcept
+    {
+        return !qgram_skips_.empty() ? qgram_skips_.data() : qgram_table_;
+    }
+
     inline std::size_t boyer_moore_scanner::get_longest_run(std::size_t& length) const
     {
         std::size_t max_skip = 0;
@@ -111,9 +213,9 @@ namespace mem
 
         std::size_t current_skip = 0;
 
-        const byte* const masks = pattern_->masks();
+        const byte* const masks = pattern_.masks();
 
-        for (std::size_t i = 0; i < pattern_->trimmed_size(); ++i)
+        for (std::size_t i = 0; i < pattern_.trimmed_size(); ++i)
         {
             if (masks[i] != 0xFF)
             {
@@ -134,7 +236,7 @@ namespace mem
         if (current_skip > max_skip)
         {
             max_skip = current_skip;
-            skip_pos = pattern_->trimmed_size() - current_skip;
+            skip_pos = pattern_.trimmed_size() - current_skip;
         }
 
         length = max_skip;
@@ -142,11 +244,123 @@ namespace mem
         return skip_pos;
     }
 
+    template <std::size_t Q>
+    MEM_STRONG_INLINE std::size_t boyer_moore_scanner::qgram_hash(const byte* values) noexcept
+    {
+        static_assert((Q == 2) || (Q == 3), "Invalid q-gram size");
+
+        std::size_t hash = 0;
+
+        for (std::size_t i = 0; i < Q; ++i)
+            hash = (hash << 4) ^ values[i];
+
+        return (hash ^ (hash >> qgram_table_bits)) & (qgram_table_size - 1);
+    }
+
+    // The q-gram window is the tail of the trimmed pattern, clipped so every shift fits in a byte.
+    // A q-gram which can match too many values to enumerate (e.g. "? ?") caps the shift of every entry.
+    inline std::size_t boyer_moore_scanner::get_qgram_skip(std::size_t q) const
+    {
+        const std::size_t trimmed_size = pattern_.trimmed_size();
+        const std::size_t window = (std::min)(trimmed_size, UINT8_MAX + q - 1);
+
+        if (window < q)
+            return 0;
+
+        const std::size_t window_start = trimmed_size - window;
+        const byte* const masks = pattern_.masks() + window_start;
+
+        std::size_t max_skip = window - q + 1;
+
+        for (std::size_t i = q - 1; i < window; ++i)
+        {
+            std::size_t combinations = 1;
+
+            for (std::size_t j = i + 1 - q; j <= i; ++j)
+            {
+                for (unsigned int free = ~masks[j] & 0xFFu; free; free &= free - 1)
+                    combinations <<= 1;
+            }
+
+            if (combinations >= qgram_table_size)
+                max_skip = (std::min)(max_skip, window - 1 - i);
+        }
+
+        return max_skip;
+    }
+
+    inline void boyer_moore_scanner::build_qgram_skips(std::size_t q, std::size_t max_skip)
+    {
+        const std::size_t trimmed_size = pattern_.trimmed_size();
+        const std::size_t window = (std::min)(trimmed_size, UINT8_MAX + q - 1);
+        const std::size_t window_start = trimmed_size - window;
+
+        const byte* const bytes = pattern_.bytes() + window_start;
+        const byte* const masks = pattern_.masks() + window_start;
+
+        qgram_skips_.assign(std::size_t(qgram_table_size), static_cast<std::uint8_t>(max_skip));
+        qgram_size_ = q;
+        skip_pos_ = trimmed_size - q;
+
+        std::vector<byte> values[3];
+
+        for (std::size_t i = q - 1; i < window; ++i)
+        {
+            const std::size_t skip = window - 1 - i;
+
+            if (skip >= max_skip)
+                continue;
+
+            std::size_t combinations = 1;
+
+            for (std::size_t j = 0; j < q; ++j)
+            {
+                const byte value = bytes[i + 1 - q + j];
+                const byte free = static_cast<byte>(~masks[i + 1 - q + j]);
+
+                // Every value v where (v & mask) == value
+                values[j].clear();
+
+                for (std::size_t sub = 0;; sub = (sub - free) & free)
+                {
+                    values[j].push_back(static_cast<byte>(value | sub));
+
+                    if (sub == free)
+                        break;
+                }
+
+                combinations *= values[j].size();
+            }
+
+            if (combinations >= qgram_table_size)
+                continue;
+
+            if (q == 2)
+                values[2].assign(1, 0);
+
+            for (byte v0 : values[0])
+            {
+                for (byte v1 : values[1])
+                {
+                    for (byte v2 : values[2])
+                    {
+                        const byte gram[3] {v0, v1, v2};
+
+                        std::uint8_t& entry = qgram_skips_[(q == 2) ? qgram_hash<2>(gram) : qgram_hash<3>(gram)];
+
+                        if (entry > skip)
+                            entry = static_cast<std::uint8_t>(skip);
+                    }
+                }
+            }
+        }
+    }
+
     inline bool boyer_moore_scanner::is_prefix(std::size_t pos) const
     {
-        const std::size_t suffix_length = pattern_->trimmed_size() - pos;
+        const std::size_t suffix_length = pattern_.trimmed_size() - pos;
 
-        const byte* const bytes = pattern_->bytes();
+        const byte* const bytes = pattern_.bytes();
 
         for (std::size_t i = 0; i < suffix_length; ++i)
             if (bytes[i] != bytes[pos + i])
@@ -157,9 +371,9 @@ namespace mem
 
     inline std::size_t boyer_moore_scanner::get_suffix_length(std::size_t pos) const
     {
-        const std::size_t last = pattern_->trimmed_size() - 1;
+        const std::size_t last = pattern_.trimmed_size() - 1;
 
-        const byte* const bytes = pattern_->bytes();
+        const byte* const bytes = pattern_.bytes();
 
         std::size_t i = 0;
 
@@ -169,14 +383,69 @@ namespace mem
         return i;
     }
 
-    inline pointer boyer_moore_scanner::scan(region range) const
+    template <std::size_t Q, typename Func>
+    inline pointer boyer_moore_scanner::scan_qgrams(const byte* current, const byte* end, Func& func) const
     {
-        const std::size_t trimmed_size = pattern_->trimmed_size();
+        const std::size_t last = pattern_.trimmed_size() - 1;
+
+        const byte* const pat_bytes = pattern_.bytes();
+        const byte* const pat_masks = pattern_.masks();
+        const std::uint8_t* const pat_skips = qgram_table();
+        const std::size_t pat_skip_pos = skip_pos_;
+
+        while (MEM_LIKELY(current < end))
+        {
+            [[MEM_ATTR_LIKELY]];
+
+            std::size_t skip = pat_skips[qgram_hash<Q>(current + pat_skip_pos)];
+            current += skip;
+
+            if (MEM_LIKELY(skip != 0)) [[MEM_ATTR_LIKELY]]
+                continue;
+
+            for (std::size_t i = last; MEM_LIKELY((current[i] & pat_masks[i]) == pat_bytes[i]); --i)
+            {
+                [[MEM_ATTR_LIKELY]];
+
+                if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
+                {
+                    if (func(current))
+                        return current;
+
+                    break;
+                }
+            }
+
+            ++current;
+        }
+
+        return nullptr;
+    }
+
+    MEM_STRONG_INLINE std::size_t boyer_moore_scanner::max_skip() const noexcept
+    {
+        return max_skip_;
+    }
+
+    MEM_STRONG_INLINE boyer_moore_tables boyer_moore_scanner::tables() const noexcept
+    {
+        return {bc_table(), gs_table(), qgram_table(), qgram_size_, skip_pos_, max_skip_};
+    }
+
+    MEM_STRONG_INLINE pointer boyer_moore_scanner::scan(region range) const
+    {
+        return scan_all(range, [](pointer) { return true; });
+    }
+
+    template <typename Func>
+    inline pointer boyer_moore_scanner::scan_all(region range, Func func) const
+    {
+        const std::size_t trimmed_size = pattern_.trimmed_size();
 
         if (!trimmed_size)
             return nullptr;
 
-        const std::size_t original_size = pattern_->size();
+        const std::size_t original_size = pattern_.size();
         const std::size_t region_size = range.size;
 
         if (original_size > region_size)
@@ -190,14 +459,23 @@ namespace mem
 
         const std::size_t last = trimmed_size - 1;
 
-        const byte* const pat_bytes = pattern_->bytes();
-        const std::size_t* const pat_skips = !bc_skips_.empty() ? bc_skips_.data() : nullptr;
+        const byte* const pat_bytes = pattern_.bytes();
+        const std::uint8_t* const pat_skips = bc_table();
+        const std::uint16_t* const pat_suffixes = gs_table();
 
-        if (pattern_->needs_masks())
+        if (pattern_.needs_masks())
         {
-            const byte* const pat_masks = pattern_->masks();
+            const byte* const pat_masks = pattern_.masks();
 
-            if (pat_skips)
+            if (qgram_size_ == 2)
+            {
+                return scan_qgrams<2>(current, end, func);
+            }
+            else if (qgram_size_ == 3)
+            {
+                return scan_qgrams<3>(current, end, func);
+            }
+            else if (pat_skips)
             {
                 const std::size_t pat_skip_pos = skip_pos_;
 
@@ -216,7 +494,12 @@ namespace mem
                         [[MEM_ATTR_LIKELY]];
 
                         if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                            return current;
+                        {
+                            if (func(current))
+                                return current;
+
+                            break;
+                        }
                     }
 
                     ++current;
@@ -236,7 +519,12 @@ namespace mem
                         [[MEM_ATTR_LIKELY]];
 
                         if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                            return current;
+                        {
+                            if (func(current))
+                                return current;
+
+                            break;
+                        }
                     }
 
                     ++current;
@@ -247,10 +535,8 @@ namespace mem
         }
         else
         {
-            if (pat_skips && !gs_skips_.empty())
+            if (pat_skips && pat_suffixes)
             {
-                const std::size_t* const pat_suffixes = gs_skips_.data();
-
                 current += last;
                 const byte* const end_plus_last = end + last;
 
@@ -260,17 +546,23 @@ namespace mem
 
                     std::size_t i = last;
 
-                    while (MEM_LIKELY(*current == pat_bytes[i]))
+                    while (MEM_LIKELY(*current == pat_bytes[i]) && MEM_LIKELY(i != 0))
                     {
                         [[MEM_ATTR_LIKELY]];
 
-                        if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                            return current;
-
                         --current;
                         --i;
                     }
 
+                    if (MEM_UNLIKELY(i == 0) && (*current == pat_bytes[0])) [[MEM_ATTR_UNLIKELY]]
+                    {
+                        if (func(current))
+                            return current;
+
+                        current += trimmed_size;
+                        continue;
+                    }
+
                     const std::size_t bc_skip = pat_skips[*current];
                     const std::size_t gs_skip = pat_suffixes[i];
 
@@ -296,7 +588,12 @@ namespace mem
                         [[MEM_ATTR_LIKELY]];
 
                         if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                            return current;
+                        {
+                            if (func(current))
+                                return current;
+
+                            break;
+                        }
                     }
 
                     ++current;
@@ -315,7 +612,12 @@ namespace mem
                         [[MEM_ATTR_LIKELY]];
 
                         if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                            return current;
+                        {
+                            if (func(current))
+                                return current;
+
+                            break;
+                        }
                     }
 
                     ++current;
@@ -20,14 +20,21 @@
 #ifndef MEMORY_SCANNER_H
 #define MEMORY_SCANNER_H
 
-#include <mem/access/remote_memory_accessor.h>
+#if defined(_WIN32)
+#    include <mem/access/remote_memory_accessor.h>
+#else
+#    include <mem/access/local_memory_accessor.h>
+#endif
 
-#include <mem/scanning/boyer_moore_scanner.h>
-#include <mem/scanning/simd_scanner.h>
+#include <mem/alloc/buffer_pool.h>
+#include <mem/memory/protect.h>
+#include <mem/memory/region_set.h>
+#include <mem/scanning/auto_scanner.h>
 
 #include <mem/scanning/pattern.h>
 #include <mem/scanning/scan_config.h>
 
+#include <algorithm>
 #include <functional>
 #include <vector>
 
@@ -38,18 +45,54 @@ namespace mem
     private:
         data_accessor& accessor_;
 
+        // Where read buffers come from, or nullptr for the pool of the calling thread
+        buffer_pool* pool_ {nullptr};
+
+        buffer_pool& get_pool() const;
+
     public:
         constexpr memory_scanner(data_accessor& accessor);
+        constexpr memory_scanner(data_accessor& accessor, buffer_pool& pool);
 
-        template <typename Scanner = boyer_moore_scanner, typename Config, typename = is_scanner<Scanner>,
+        template <typename Scanner = auto_scanner, typename Config, typename = is_scanner<Scanner>,
             typename = is_scan_config<Config>>
         std::vector<pointer> scan(Scanner&& scanner, Config&& config) const;
 
-        template <typename Scanner = boyer_moore_scanner, typename... Args, typename Config,
+        // Stores the results in storage instead of on the heap
+        template <typename Scanner, typename Config, typename = is_scanner<Scanner>,
+            typename = is_scan_config<Config>>
+        arena_vector<pointer> scan(const Scanner& scanner, const Config& config, arena& storage) const;
+
+        template <typename Scanner = auto_scanner, typename... Args, typename Config,
             typename = is_scanner<Scanner>, typename = is_scan_config<Config>>
         auto scan(Config&& config, Args&&... args) const;
 
-        template <typename Scanner = boyer_moore_scanner, typename... Args>
+        // Calls func with each result, stopping when it returns true. Returns the result func stopped at.
+        template <typename Scanner, typename Config, typename Func, typename = is_scanner<Scanner>,
+            typename = is_scan_config<Config>>
+        pointer scan_each(const Scanner& scanner, const Config& config, Func func) const;
+
+        template <typename Scanner, typename Config, typename OutputIt, typename = is_scanner<Scanner>,
+            typename = is_scan_config<Config>>
+        OutputIt scan_into(const Scanner& scanner, const Config& config, OutputIt out) const;
+
+        // Writes up to capacity results, returns the total number of results (which may exceed capacity)
+        template <typename Scanner, typename Config, typename = is_scanner<Scanner>,
+            typename = is_scan_config<Config>>
+        std::size_t scan_into(const Scanner& scanner, const Config& config, pointer* results, std::size_t capacity) const;
+
+        template <typename Scanner, typename Config, typename = is_scanner<Scanner>,
+            typename = is_scan_config<Config>>
+        std::size_t scan_count(const Scanner& scanner, const Config& config) const;
+
+        template <typename Scanner, typename Config, typename = is_scanner<Scanner>,
+            typename = is_scan_config<Config>>
+        std::vector<pointer> scan_first(const Scanner& scanner, const Config& config, std::size_t count) const;
+
+        // The mapped regions matching config.flags within config's bounds and ranges, with neighbours merged
+        region_set matching_regions(const scan_config& config) const;
+
+        template <typename Scanner = auto_scanner, typename... Args>
         constexpr static auto scan_default(Args&&... args);
 
         constexpr const data_accessor& get_accessor() const;
@@ -59,55 +102,152 @@ namespace mem
         : accessor_(accessor)
     {}
 
-    template <typename Scanner, typename Config, typename, typename>
-    MEM_STRONG_INLINE std::vector<pointer> memory_scanner::scan(Scanner&& scanner, Config&& config) const
+    constexpr memory_scanner::memory_scanner(data_accessor& accessor, buffer_pool& pool)
+        : accessor_(accessor)
+        , pool_(&pool)
+    {}
+
+    MEM_STRONG_INLINE buffer_pool& memory_scanner::get_pool() const
+    {
+        return pool_ ? *pool_ : buffer_pool::thread_pool();
+    }
+
+    template <typename Scanner, typename Config, typename Func, typename, typename>
+    inline pointer memory_scanner::scan_each(const Scanner& scanner, const Config& config, Func func) const
     {
         if (!scanner.is_ready())
         {
-            return {};
+            return nullptr;
         }
 
-        std::vector<pointer> results;
-
         size_t overlap = scanner.pattern_size() - 1;
-        std::vector<byte> buffer(config.block_size + overlap);
-        region scan_region(buffer.data(), buffer.size());
 
-        void* current = config.start;
+        // Reused between scans and left uninitialized, since every block is read before it is scanned
+        const buffer_pool::buffer buffer = get_pool().acquire(config.block_size + overlap);
+        region scan_region(buffer.data(), config.block_size + overlap);
+
+        const size_t page = page_size();
+
+        const auto scan_range = [&](size_t scan_start, size_t scan_end) -> pointer {
+            for (size_t read_pos = scan_start, next_pos; read_pos < scan_end; read_pos = next_pos)
+            {
+                const size_t wanted = std::min(config.block_size + overlap, scan_end - read_pos);
+
+                scan_region.size = accessor_.read_partial(reinterpret_cast<void*>(read_pos), buffer.data(), wanted);
+                next_pos = read_pos + config.block_size;
 
-        while (current < config.end)
+                if (scan_region.size != wanted)
+                {
+                    // Scan what was read, then carry on after the page which could not be
+                    next_pos = ((read_pos + scan_region.size) | (page - 1)) + 1;
+
+                    if (config.stats)
+                        config.stats->bytes_unreadable += std::min(next_pos, scan_end) - (read_pos + scan_region.size);
+
+                    if (scan_region.size <= overlap)
+                        continue;
+                }
+
+                pointer stopped = nullptr;
+
+                scanner.scan_all(scan_region, [&](const pointer& p) {
+                    const pointer result = read_pos + static_cast<std::size_t>(p - buffer.data());
+
+                    if (func(result))
+                    {
+                        stopped = result;
+                        return true;
+                    }
+
+                    return false;
+                });
+
+                if (stopped)
+                    return stopped;
+            }
+
+            return nullptr;
+        };
+
+        // Residency of up to this many pages is queried at once
+        const size_t max_pages = (config.residency == scan_residency::resident) ? 4096 : 0;
+        std::vector<byte> resident(max_pages);
+
+        for (const region& span : matching_regions(config))
         {
-            region_info region_info = {};
-            if (!accessor_.query_region(current, region_info))
+            size_t scan_start = span.start.as<std::uintptr_t>();
+            size_t scan_end = scan_start + span.size;
+
+            if (!max_pages)
             {
-                break;
+                if (const pointer stopped = scan_range(scan_start, scan_end))
+                    return stopped;
+
+                continue;
             }
 
-            if (region_info.flags == config.flags)
+            // Runs of resident pages are scanned as they end, everything else is skipped
+            size_t run_start = scan_start;
+
+            for (size_t chunk = scan_start & ~(page - 1); chunk < scan_end; chunk += max_pages * page)
             {
-                size_t base_address = reinterpret_cast<size_t>(region_info.start);
-                size_t region_size = region_info.size;
+                const size_t pages = std::min(max_pages, (scan_end - chunk + page - 1) / page);
 
-                size_t scan_start = std::max(reinterpret_cast<size_t>(current), base_address);
-                size_t scan_end = std::min(reinterpret_cast<size_t>(config.end), base_address + region_size);
-                size_t scan_size = scan_end - scan_start;
+                if (!accessor_.query_residency(reinterpret_cast<void*>(chunk), pages * page, resident.data()))
+                    std::fill_n(resident.begin(), pages, byte(1));
 
-                for (size_t read_pos = scan_start; read_pos < scan_end; read_pos += config.block_size)
+                for (size_t i = 0; i < pages; ++i)
                 {
-                    scan_region.size = std::min(config.block_size + overlap, scan_end - read_pos);
-                    if (!accessor_.read(reinterpret_cast<void*>(read_pos), buffer.data(), scan_region.size))
+                    if (resident[i])
                         continue;
 
-                    scanner.scan_all(scan_region, [&](const pointer& p) {
-                        results.push_back(p - buffer.data() + read_pos);
-                        return false;
-                    });
+                    const size_t page_start = std::max(chunk + i * page, scan_start);
+                    const size_t page_end = std::min(chunk + (i + 1) * page, scan_end);
+
+                    if (run_start < page_start)
+                    {
+                        if (const pointer stopped = scan_range(run_start, page_start))
+                            return stopped;
+                    }
+
+                    run_start = page_end;
+
+                    if (config.stats)
+                        config.stats->bytes_skipped += page_end - page_start;
                 }
             }
 
-            current = static_cast<byte*>(region_info.start) + region_info.size;
+            if (const pointer stopped = scan_range(run_start, scan_end))
+                return stopped;
         }
 
+        return nullptr;
+    }
+
+    template <typename Scanner, typename Config, typename, typename>
+    MEM_STRONG_INLINE std::vector<pointer> memory_scanner::scan(Scanner&& scanner, Config&& config) const
+    {
+        std::vector<pointer> results;
+
+        scan_each(scanner, config, [&results](pointer result) {
+            results.push_back(result);
+            return false;
+        });
+
+        return results;
+    }
+
+    template <typename Scanner, typename Config, typename, typename>
+    MEM_STRONG_INLINE arena_vector<pointer> memory_scanner::scan(
+        const Scanner& scanner, const Config& config, arena& storage) const
+    {
+        arena_vector<pointer> results {arena_allocator<pointer>(storage)};
+
+        scan_each(scanner, config, [&results](pointer result) {
+            results.push_back(result);
+            return false;
+        });
+
         return results;
     }
 
@@ -118,9 +258,125 @@ namespace mem
         return scan<Scanner>(std::move(scanner), std::forward<Config>(config));
     }
 
+    template <typename Scanner, typename Config, typename OutputIt, typename, typename>
+    MEM_STRONG_INLINE OutputIt memory_scanner::scan_into(const Scanner& scanner, const Config& config, OutputIt out) const
+    {
+        scan_each(scanner, config, [&out](pointer result) {
+            *out++ = result;
+            return false;
+        });
+
+        return out;
+    }
+
+    template <typename Scanner, typename Config, typename, typename>
+    MEM_STRONG_INLINE std::size_t memory_scanner::scan_into(
+        const Scanner& scanner, const Config& config, pointer* results, std::size_t capacity) const
+    {
+        std::size_t total = 0;
+
+        scan_each(scanner, config, [&](pointer result) {
+            if (total < capacity)
+                results[total] = result;
+
+            ++total;
+            return false;
+        });
+
+        return total;
+    }
+
+    template <typename Scanner, typename Config, typename, typename>
+    MEM_STRONG_INLINE std::size_t memory_scanner::scan_count(const Scanner& scanner, const Config& config) const
+    {
+        std::size_t total = 0;
+
+        scan_each(scanner, config, [&total](pointer) {
+            ++total;
+            return false;
+        });
+
+        return total;
+    }
+
+    template <typename Scanner, typename Config, typename, typename>
+    MEM_STRONG_INLINE std::vector<pointer> memory_scanner::scan_first(
+        const Scanner& scanner, const Config& config, std::size_t count) const
+    {
+        std::vector<pointer> results;
+
+        if (!count)
+            return results;
+
+        results.reserve(count);
+
+        scan_each(scanner, config, [&results, count](pointer result) {
+            results.push_back(result);
+            return results.size() == count;
+        });
+
+        return results;
+    }
+
+    inline region_set memory_scanner::matching_regions(const scan_config& config) const
+    {
+        region_set result;
+
+        const std::uintptr_t bounds_start = reinterpret_cast<std::uintptr_t>(config.start);
+        const std::uintptr_t bounds_end = reinterpret_cast<std::uintptr_t>(config.end);
+
+        const auto walk = [&](std::uintptr_t start, std::uintptr_t end) {
+            std::uintptr_t current = start;
+
+            while (current < end)
+            {
+                region_info info = {};
+                if (!accessor_.query_region(reinterpret_cast<void*>(current), info))
+                    break;
+
+                const std::uintptr_t region_start = reinterpret_cast<std::uintptr_t>(info.start);
+                const std::uintptr_t region_end = region_start + info.size;
+
+                if (region_end <= current)
+                    break;
+
+                if (info.flags == config.flags)
+                {
+                    const std::uintptr_t scan_start = std::max(current, region_start);
+                    const std::uintptr_t scan_end = std::min(end, region_end);
+
+                    result.insert(region(scan_start, scan_end - scan_start));
+                }
+
+                current = region_end;
+            }
+        };
+
+        if (config.ranges.empty())
+        {
+            walk(bounds_start, bounds_end);
+        }
+        else
+        {
+            for (const region& range : config.ranges)
+            {
+                const std::uintptr_t start = std::max(range.start.as<std::uintptr_t>(), bounds_start);
+                const std::uintptr_t end = std::min(range.start.as<std::uintptr_t>() + range.size, bounds_end);
+
+                walk(start, end);
+            }
+        }
+
+        return result;
+    }
+
     MEM_STRONG_INLINE memory_scanner& get_default_scanner()
     {
+#if defined(_WIN32)
         static memory_scanner instance(current_process_accessor::get_instance());
+#else
+        static memory_scanner instance(get_default_accessor());
+#endif
         return instance;
     }
 
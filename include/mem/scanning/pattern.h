@@ -20,11 +20,14 @@
 #ifndef MEM_PATTERN_BRICK_H
 #define MEM_PATTERN_BRICK_H
 
+#include <mem/alloc/arena.h>
 #include <mem/containers/char_queue.h>
 
 #include <mem/memory/mem.h>
 #include <mem/memory/region.h>
+#include <mem/utils/hex.h>
 
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -74,6 +77,41 @@ namespace mem
         std::string to_string() const;
     };
 
+    // A pattern stored elsewhere, as used by the scanners. The bytes must already be masked.
+    class pattern_view
+    {
+    private:
+        const byte* bytes_ {nullptr};
+        const byte* masks_ {nullptr};
+        std::size_t size_ {0};
+        std::size_t trimmed_size_ {0};
+        bool needs_masks_ {false};
+
+    public:
+        pattern_view() noexcept = default;
+
+        pattern_view(const pattern& pattern) noexcept;
+        pattern_view(const byte* bytes, const byte* masks, std::size_t size) noexcept;
+        pattern_view(const byte* bytes, const byte* masks, std::size_t size, std::size_t trimmed_size,
+            bool needs_masks) noexcept;
+
+        bool match(pointer address) const noexcept;
+
+        const byte* bytes() const noexcept;
+        const byte* masks() const noexcept;
+
+        std::size_t size() const noexcept;
+        std::size_t trimmed_size() const noexcept;
+
+        bool needs_masks() const noexcept;
+
+        std::size_t get_skip_pos(const byte* frequencies) const noexcept;
+
+        explicit operator bool() const noexcept;
+
+        std::string to_string() const;
+    };
+
     mem::pointer scan(const mem::pattern& pattern, mem::region range);
     std::vector<mem::pointer> scan_all(const mem::pattern& pattern, mem::region range);
 
@@ -276,7 +314,12 @@ namespace mem
         }
     }
 
-    inline bool pattern::match(pointer address) const noexcept
+    MEM_STRONG_INLINE bool pattern::match(pointer address) const noexcept
+    {
+        return pattern_view(*this).match(address);
+    }
+
+    inline bool pattern_view::match(pointer address) const noexcept
     {
         const byte* const pat_bytes = bytes();
 
@@ -293,7 +336,7 @@ namespace mem
         {
             const byte* const pat_masks = masks();
 
-            for (std::size_t i = last; MEM_LIKELY((current[i] & pat_masks[i]) != pat_bytes[i]); --i)
+            for (std::size_t i = last; MEM_LIKELY((current[i] & pat_masks[i]) == pat_bytes[i]); --i)
             {
                 if (MEM_UNLIKELY(i == 0))
                     return true;
@@ -303,7 +346,7 @@ namespace mem
         }
         else
         {
-            for (std::size_t i = last; MEM_LIKELY(current[i] != pat_bytes[i]); --i)
+            for (std::size_t i = last; MEM_LIKELY(current[i] == pat_bytes[i]); --i)
             {
                 if (MEM_UNLIKELY(i == 0))
                     return true;
@@ -338,7 +381,7 @@ namespace mem
         return needs_masks_;
     }
 
-    MEM_STRONG_INLINE std::size_t pattern::get_skip_pos(const byte* frequencies) const noexcept
+    inline std::size_t pattern_view::get_skip_pos(const byte* frequencies) const noexcept
     {
         std::size_t min = SIZE_MAX;
         std::size_t result = SIZE_MAX;
@@ -365,17 +408,100 @@ namespace mem
         return !bytes_.empty() && !masks_.empty();
     }
 
+    MEM_STRONG_INLINE std::size_t pattern::get_skip_pos(const byte* frequencies) const noexcept
+    {
+        return pattern_view(*this).get_skip_pos(frequencies);
+    }
+
     inline std::string pattern::to_string() const
     {
-        const char* const hex_chars = "0123456789ABCDEF";
+        return pattern_view(*this).to_string();
+    }
+
+    MEM_STRONG_INLINE pattern_view::pattern_view(const pattern& pattern) noexcept
+        : bytes_(pattern.bytes())
+        , masks_(pattern.masks())
+        , size_(pattern.size())
+        , trimmed_size_(pattern.trimmed_size())
+        , needs_masks_(pattern.needs_masks())
+    {}
+
+    inline pattern_view::pattern_view(const byte* bytes, const byte* masks, std::size_t size) noexcept
+        : bytes_(size ? bytes : nullptr)
+        , masks_(size ? masks : nullptr)
+        , size_(size)
+    {
+        trimmed_size_ = size_;
+
+        while (trimmed_size_ && (masks_[trimmed_size_ - 1] == 0x00))
+        {
+            --trimmed_size_;
+        }
+
+        for (std::size_t i = trimmed_size_; i--;)
+        {
+            if (masks_[i] != 0xFF)
+            {
+                needs_masks_ = true;
+
+                break;
+            }
+        }
+    }
+
+    MEM_STRONG_INLINE pattern_view::pattern_view(const byte* bytes, const byte* masks, std::size_t size,
+        std::size_t trimmed_size, bool needs_masks) noexcept
+        : bytes_(size ? bytes : nullptr)
+        , masks_(size ? masks : nullptr)
+        , size_(size)
+        , trimmed_size_(trimmed_size)
+        , needs_masks_(needs_masks)
+    {}
+
+    MEM_STRONG_INLINE const byte* pattern_view::bytes() const noexcept
+    {
+        return bytes_;
+    }
+
+    MEM_STRONG_INLINE const byte* pattern_view::masks() const noexcept
+    {
+        return masks_;
+    }
+
+    MEM_STRONG_INLINE std::size_t pattern_view::size() const noexcept
+    {
+        return size_;
+    }
+
+    MEM_STRONG_INLINE std::size_t pattern_view::trimmed_size() const noexcept
+    {
+        return trimmed_size_;
+    }
 
-        std::string result;
+    MEM_STRONG_INLINE bool pattern_view::needs_masks() const noexcept
+    {
+        return needs_masks_;
+    }
+
+    MEM_STRONG_INLINE pattern_view::operator bool() const noexcept
+    {
+        return bytes_ && masks_;
+    }
+
+    inline std::string pattern_view::to_string() const
+    {
+        const char* const hex_chars = internal::hex_digits(true);
+
+        // At most "XX&XX " per byte
+        std::string result(size() * 6, '\0');
+
+        char* current = &result[0];
 
         for (std::size_t i = 0; i < size(); ++i)
         {
             if (i)
             {
-                result += ' ';
+                *current++ = ' ';
             }
 
             const byte mask = masks_[i];
@@ -383,45 +509,112 @@ namespace mem
 
             if (mask != 0x00)
             {
-                result += hex_chars[static_cast<std::size_t>(value >> 4)];
-                result += hex_chars[static_cast<std::size_t>(value & 0xF)];
+                *current++ = hex_chars[static_cast<std::size_t>(value >> 4)];
+                *current++ = hex_chars[static_cast<std::size_t>(value & 0xF)];
 
                 if (mask != 0xFF)
                 {
-                    result += '&';
-                    result += hex_chars[static_cast<std::size_t>(mask >> 4)];
-                    result += hex_chars[static_cast<std::size_t>(mask & 0xF)];
+                    *current++ = '&';
+                    *current++ = hex_chars[static_cast<std::size_t>(mask >> 4)];
+                    *current++ = hex_chars[static_cast<std::size_t>(mask & 0xF)];
                 }
             }
             else
             {
-                result += '?';
+                *current++ = '?';
             }
         }
 
+        result.resize(static_cast<std::size_t>(current - result.data()));
+
         return result;
     }
 
+    template <typename Scanner>
+    class scan_range;
+
     template <typename Scanner>
     class scanner_base
     {
     protected:
-        const pattern* pattern_ {nullptr};
+        pattern_view pattern_ {};
 
     public:
         scanner_base() noexcept = default;
-        scanner_base(const pattern& pattern) noexcept;
+        scanner_base(pattern_view pattern) noexcept;
 
         bool is_ready() const;
 
         std::size_t pattern_size() const;
 
+        pattern_view get_pattern() const noexcept;
+
         pointer operator()(region range) const;
 
         template <typename Func>
         pointer scan_all(region range, Func func) const;
 
         std::vector<pointer> scan_all(region range) const;
+
+        // Stores the results in storage instead of on the heap
+        arena_vector<pointer> scan_all(region range, arena& storage) const;
+
+        // Writes every result to out
+        template <typename OutputIt>
+        OutputIt scan_into(region range, OutputIt out) const;
+
+        // Writes up to capacity results, returns the total number of results (which may exceed capacity)
+        std::size_t scan_into(region range, pointer* results, std::size_t capacity) const;
+
+        std::size_t scan_count(region range) const;
+
+        // Stops after the first count results
+        std::vector<pointer> scan_first(region range, std::size_t count) const;
+
+        // Lazily scans for the next result as the range is iterated
+        scan_range<Scanner> hits(region range) const;
+    };
+
+    template <typename Scanner>
+    class scan_iterator
+    {
+    private:
+        const Scanner* scanner_ {nullptr};
+        region range_ {};
+        mem::pointer current_ {nullptr};
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = mem::pointer;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        scan_iterator() noexcept = default;
+        scan_iterator(const Scanner& scanner, region range);
+
+        reference operator*() const noexcept;
+        pointer operator->() const noexcept;
+
+        scan_iterator& operator++();
+        scan_iterator operator++(int);
+
+        bool operator==(const scan_iterator& rhs) const noexcept;
+        bool operator!=(const scan_iterator& rhs) const noexcept;
+    };
+
+    template <typename Scanner>
+    class scan_range
+    {
+    private:
+        const Scanner* scanner_ {nullptr};
+        region range_ {};
+
+    public:
+        scan_range(const Scanner& scanner, region range) noexcept;
+
+        scan_iterator<Scanner> begin() const;
+        scan_iterator<Scanner> end() const noexcept;
     };
 
     template <typename Scanner>
@@ -429,19 +622,25 @@ namespace mem
         std::is_base_of<scanner_base<std::decay_t<Scanner>>, std::decay_t<Scanner>>::value>::type;
 
     template <typename Scanner>
-    scanner_base<Scanner>::scanner_base(const pattern& pattern) noexcept
-        : pattern_(&pattern) {};
+    scanner_base<Scanner>::scanner_base(pattern_view pattern) noexcept
+        : pattern_(pattern) {};
 
     template <typename Scanner>
     bool scanner_base<Scanner>::is_ready() const
     {
-        return pattern_ != nullptr;
+        return static_cast<bool>(pattern_);
     }
 
     template <typename Scanner>
     std::size_t scanner_base<Scanner>::pattern_size() const
     {
-        return pattern_ ? pattern_->size() : 0;
+        return pattern_.size();
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE pattern_view scanner_base<Scanner>::get_pattern() const noexcept
+    {
+        return pattern_;
     }
 
     template <typename Scanner>
@@ -481,7 +680,21 @@ namespace mem
     {
         std::vector<pointer> results;
 
-        scan_all(range, [&results](pointer result) {
+        static_cast<const Scanner*>(this)->scan_all(range, [&results](pointer result) {
+            results.emplace_back(result);
+
+            return false;
+        });
+
+        return results;
+    }
+
+    template <typename Scanner>
+    inline arena_vector<pointer> scanner_base<Scanner>::scan_all(region range, arena& storage) const
+    {
+        arena_vector<pointer> results {arena_allocator<pointer>(storage)};
+
+        static_cast<const Scanner*>(this)->scan_all(range, [&results](pointer result) {
             results.emplace_back(result);
 
             return false;
@@ -489,6 +702,141 @@ namespace mem
 
         return results;
     }
+
+    template <typename Scanner>
+    template <typename OutputIt>
+    inline OutputIt scanner_base<Scanner>::scan_into(region range, OutputIt out) const
+    {
+        static_cast<const Scanner*>(this)->scan_all(range, [&out](pointer result) {
+            *out++ = result;
+
+            return false;
+        });
+
+        return out;
+    }
+
+    template <typename Scanner>
+    inline std::size_t scanner_base<Scanner>::scan_into(region range, pointer* results, std::size_t capacity) const
+    {
+        std::size_t total = 0;
+
+        static_cast<const Scanner*>(this)->scan_all(range, [&](pointer result) {
+            if (total < capacity)
+                results[total] = result;
+
+            ++total;
+
+            return false;
+        });
+
+        return total;
+    }
+
+    template <typename Scanner>
+    inline std::size_t scanner_base<Scanner>::scan_count(region range) const
+    {
+        std::size_t total = 0;
+
+        static_cast<const Scanner*>(this)->scan_all(range, [&total](pointer) {
+            ++total;
+
+            return false;
+        });
+
+        return total;
+    }
+
+    template <typename Scanner>
+    inline std::vector<pointer> scanner_base<Scanner>::scan_first(region range, std::size_t count) const
+    {
+        std::vector<pointer> results;
+
+        if (!count)
+            return results;
+
+        results.reserve(count);
+
+        static_cast<const Scanner*>(this)->scan_all(range, [&results, count](pointer result) {
+            results.emplace_back(result);
+
+            return results.size() == count;
+        });
+
+        return results;
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE scan_range<Scanner> scanner_base<Scanner>::hits(region range) const
+    {
+        return {*static_cast<const Scanner*>(this), range};
+    }
+
+    template <typename Scanner>
+    inline scan_iterator<Scanner>::scan_iterator(const Scanner& scanner, region range)
+        : scanner_(&scanner)
+        , range_(range)
+        , current_(scanner.scan(range))
+    {}
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE typename scan_iterator<Scanner>::reference scan_iterator<Scanner>::operator*() const noexcept
+    {
+        return current_;
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE typename scan_iterator<Scanner>::pointer scan_iterator<Scanner>::operator->() const noexcept
+    {
+        return &current_;
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE scan_iterator<Scanner>& scan_iterator<Scanner>::operator++()
+    {
+        range_ = range_.sub_region(current_ + 1);
+        current_ = scanner_->scan(range_);
+
+        return *this;
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE scan_iterator<Scanner> scan_iterator<Scanner>::operator++(int)
+    {
+        scan_iterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE bool scan_iterator<Scanner>::operator==(const scan_iterator& rhs) const noexcept
+    {
+        return current_ == rhs.current_;
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE bool scan_iterator<Scanner>::operator!=(const scan_iterator& rhs) const noexcept
+    {
+        return current_ != rhs.current_;
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE scan_range<Scanner>::scan_range(const Scanner& scanner, region range) noexcept
+        : scanner_(&scanner)
+        , range_(range)
+    {}
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE scan_iterator<Scanner> scan_range<Scanner>::begin() const
+    {
+        return {*scanner_, range_};
+    }
+
+    template <typename Scanner>
+    MEM_STRONG_INLINE scan_iterator<Scanner> scan_range<Scanner>::end() const noexcept
+    {
+        return {};
+    }
 } // namespace mem
 
 #include "simd_scanner.h"
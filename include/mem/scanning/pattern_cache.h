@@ -20,9 +20,13 @@
 #ifndef MEM_PATTERN_CACHE_BRICK_H
 #define MEM_PATTERN_CACHE_BRICK_H
 
+#include <mem/alloc/arena.h>
 #include <mem/hash/hasher.h>
 #include <mem/scanning/pattern.h>
 
+#include <iterator>
+#include <memory>
+#include <vector>
 #include <unordered_map>
 
 #include <istream>
@@ -30,31 +34,46 @@
 
 namespace mem
 {
-    class pattern_cache
+    // Results are kept in a std::vector<pointer, Allocator>
+    template <typename Allocator = std::allocator<pointer>>
+    class basic_pattern_cache
     {
+    public:
+        using result_list = std::vector<pointer, Allocator>;
+
     private:
         struct pattern_results
         {
-            std::vector<pointer> results {};
+            result_list results {};
             bool checked {false};
         };
 
         region region_;
         std::unordered_map<std::uint32_t, pattern_results> results_;
 
+        Allocator allocator_;
+
         static std::uint32_t hash_pattern(const pattern& pattern);
 
+        result_list scan_region(const pattern& pattern) const;
+
     public:
-        pattern_cache(region range);
+        basic_pattern_cache(region range, const Allocator& allocator = Allocator());
 
         pointer scan(const pattern& pattern, std::size_t index = 0, std::size_t expected = 1);
-        const std::vector<pointer>& scan_all(const pattern& pattern);
+        const result_list& scan_all(const pattern& pattern);
 
         void save(std::ostream& output) const;
         bool load(std::istream& input);
     };
 
-    inline std::uint32_t pattern_cache::hash_pattern(const pattern& pattern)
+    using pattern_cache = basic_pattern_cache<>;
+
+    // Stores every result in an arena, which must outlive the cache
+    using arena_pattern_cache = basic_pattern_cache<arena_allocator<pointer>>;
+
+    template <typename Allocator>
+    inline std::uint32_t basic_pattern_cache<Allocator>::hash_pattern(const pattern& pattern)
     {
         hasher hash;
 
@@ -74,11 +93,26 @@ namespace mem
         return hash.digest();
     }
 
-    inline pattern_cache::pattern_cache(region range)
+    template <typename Allocator>
+    inline basic_pattern_cache<Allocator>::basic_pattern_cache(region range, const Allocator& allocator)
         : region_(range)
+        , allocator_(allocator)
     {}
 
-    inline pointer pattern_cache::scan(const pattern& pattern, std::size_t index, std::size_t expected)
+    template <typename Allocator>
+    inline typename basic_pattern_cache<Allocator>::result_list basic_pattern_cache<Allocator>::scan_region(
+        const pattern& pattern) const
+    {
+        result_list results {allocator_};
+
+        default_scanner scanner(pattern);
+        scanner.scan_into(region_, std::back_inserter(results));
+
+        return results;
+    }
+
+    template <typename Allocator>
+    inline pointer basic_pattern_cache<Allocator>::scan(const pattern& pattern, std::size_t index, std::size_t expected)
     {
         const auto& results = scan_all(pattern);
 
@@ -95,7 +129,9 @@ namespace mem
         return results[index];
     }
 
-    inline const std::vector<pointer>& pattern_cache::scan_all(const pattern& pattern)
+    template <typename Allocator>
+    inline const typename basic_pattern_cache<Allocator>::result_list& basic_pattern_cache<Allocator>::scan_all(
+        const pattern& pattern)
     {
         const std::uint32_t hash = hash_pattern(pattern);
 
@@ -119,18 +155,14 @@ namespace mem
 
                 if (changed)
                 {
-                    default_scanner scanner(pattern);
-
-                    find->second.results = scanner.scan_all(region_);
+                    find->second.results = scan_region(pattern);
                 }
             }
         }
         else
         {
             pattern_results results;
-
-            default_scanner scanner(pattern);
-            results.results = scanner.scan_all(region_);
+            results.results = scan_region(pattern);
 
             find = results_.emplace(hash, std::move(results)).first;
         }
@@ -163,7 +195,8 @@ namespace mem
         }
     } // namespace stream
 
-    inline void pattern_cache::save(std::ostream& output) const
+    template <typename Allocator>
+    inline void basic_pattern_cache<Allocator>::save(std::ostream& output) const
     {
         stream::write<std::uint32_t>(output, 0x50415443); // PATC
         stream::write<std::uint32_t>(output, sizeof(std::size_t));
@@ -182,7 +215,8 @@ namespace mem
         }
     }
 
-    inline bool pattern_cache::load(std::istream& input)
+    template <typename Allocator>
+    inline bool basic_pattern_cache<Allocator>::load(std::istream& input)
     {
         try
         {
@@ -205,6 +239,7 @@ namespace mem
                 const std::size_t result_count = stream::read<std::size_t>(input);
 
                 pattern_results results;
+                results.results = result_list(allocator_);
                 results.checked = false;
                 results.results.reserve(result_count);
 
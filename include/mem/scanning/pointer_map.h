@@ -0,0 +1,332 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_POINTER_MAP_BRICK_H
+#define MEM_POINTER_MAP_BRICK_H
+
+#include <mem/access/data_accessor.h>
+#include <mem/containers/slice.h>
+#include <mem/memory/protect.h>
+#include <mem/memory/region_set.h>
+#include <mem/scanning/scan_config.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#if defined(MEM_SIMD_AVX2)
+#    include <immintrin.h>
+#endif
+
+namespace mem
+{
+    struct pointer_map_entry
+    {
+        std::uintptr_t value;    // The pointer
+        std::uintptr_t location; // Where it is stored
+    };
+
+    struct pointer_path
+    {
+        // A location inside the roots
+        pointer base {nullptr};
+
+        // Applied after each dereference: target == *(*(*base + offsets[0]) + offsets[1]) + ...
+        std::vector<std::size_t> offsets {};
+    };
+
+    // Every aligned pointer sized value in a set of regions which points into a set of targets,
+    // sorted by value to answer "who points into [a, b)" in O(log n).
+    class pointer_map
+    {
+    private:
+        std::vector<pointer_map_entry> entries_ {};
+
+        // Appends the aligned words of block which fall in targets
+        static void collect(std::vector<pointer_map_entry>& entries, const std::uintptr_t* words, std::size_t count,
+            std::uintptr_t location, const region_set& targets);
+
+    public:
+        pointer_map() = default;
+
+        // Reads sources through accessor in block_size chunks, keeping values which point into targets.
+        // A chunk which cannot be read in full is kept up to the first page it could not read.
+        static pointer_map build(const data_accessor& accessor, const region_set& sources, const region_set& targets,
+            std::size_t block_size = scan_default_block_size);
+
+        // Maps every region of accessor whose flags include flags, using the same regions as sources and targets
+        static pointer_map build(const data_accessor& accessor, prot_flags flags = prot_flags::RW);
+
+        // The mapped regions of accessor whose flags include flags
+        static region_set mapped_regions(const data_accessor& accessor, prot_flags flags);
+
+        // Entries whose value lies in range, sorted by value
+        slice<const pointer_map_entry> pointing_into(region range) const noexcept;
+
+        // Reverse breadth first search from target, through at most max_depth dereferences, each followed by an
+        // offset of at most max_offset. Returns paths which start inside roots, shortest first.
+        std::vector<pointer_path> find_paths(pointer target, const region_set& roots, std::size_t max_depth,
+            std::size_t max_offset, std::size_t max_results = SIZE_MAX) const;
+
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        const pointer_map_entry* begin() const noexcept;
+        const pointer_map_entry* end() const noexcept;
+    };
+
+    // Follows path through accessor, returning nullptr if any read fails
+    pointer resolve(const pointer_path& path, const data_accessor& accessor);
+
+    inline void pointer_map::collect(std::vector<pointer_map_entry>& entries, const std::uintptr_t* words,
+        std::size_t count, std::uintptr_t location, const region_set& targets)
+    {
+        if (targets.empty())
+            return;
+
+        const region& last = targets[targets.size() - 1];
+
+        const std::uintptr_t lowest = targets[0].start.as<std::uintptr_t>();
+        const std::uintptr_t extent = last.start.as<std::uintptr_t>() + last.size - lowest;
+
+        const auto check = [&](std::size_t i) {
+            if ((words[i] - lowest < extent) && targets.contains(words[i]))
+                entries.push_back({words[i], location + i * sizeof(std::uintptr_t)});
+        };
+
+        std::size_t i = 0;
+
+#if defined(MEM_SIMD_AVX2) && defined(MEM_ARCH_X86_64)
+        // Unsigned (word - lowest) < extent, as a signed compare after flipping the sign bits
+        const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+        const __m256i base = _mm256_set1_epi64x(static_cast<long long>(lowest));
+        const __m256i limit = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(extent)), sign);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i + 4));
+
+            const __m256i hits = _mm256_or_si256(
+                _mm256_cmpgt_epi64(limit, _mm256_xor_si256(_mm256_sub_epi64(lo, base), sign)),
+                _mm256_cmpgt_epi64(limit, _mm256_xor_si256(_mm256_sub_epi64(hi, base), sign)));
+
+            if (MEM_LIKELY(!_mm256_movemask_epi8(hits)))
+                continue;
+
+            for (std::size_t j = i; j < i + 8; ++j)
+                check(j);
+        }
+#else
+        // Branch free bounds filter, which the compiler can vectorize
+        for (; i + 4 <= count; i += 4)
+        {
+            const bool any = ((words[i] - lowest) < extent) | ((words[i + 1] - lowest) < extent) |
+                ((words[i + 2] - lowest) < extent) | ((words[i + 3] - lowest) < extent);
+
+            if (MEM_LIKELY(!any))
+                continue;
+
+            for (std::size_t j = i; j < i + 4; ++j)
+                check(j);
+        }
+#endif
+
+        for (; i < count; ++i)
+            check(i);
+    }
+
+    inline pointer_map pointer_map::build(
+        const data_accessor& accessor, const region_set& sources, const region_set& targets, std::size_t block_size)
+    {
+        pointer_map result;
+
+        block_size = (std::max)(block_size / sizeof(std::uintptr_t), std::size_t(1)) * sizeof(std::uintptr_t);
+
+        std::vector<std::uintptr_t> buffer(block_size / sizeof(std::uintptr_t));
+
+        const std::uintptr_t page = page_size();
+
+        for (const region& source : sources)
+        {
+            const pointer source_end = source.start.add(source.size);
+
+            const std::uintptr_t start = source.start.align_up(sizeof(std::uintptr_t)).as<std::uintptr_t>();
+            const std::uintptr_t end = source_end.align_down(sizeof(std::uintptr_t)).as<std::uintptr_t>();
+
+            for (std::uintptr_t current = start, next; current < end; current = next)
+            {
+                const std::size_t size = (std::min)(block_size, static_cast<std::size_t>(end - current));
+                const std::size_t length = accessor.read_partial(reinterpret_cast<void*>(current), buffer.data(), size);
+
+                next = current + size;
+
+                // Carry on after the page which could not be read
+                if (length != size)
+                    next = ((current + length) | (page - 1)) + 1;
+
+                collect(result.entries_, buffer.data(), length / sizeof(std::uintptr_t), current, targets);
+            }
+        }
+
+        std::sort(result.entries_.begin(), result.entries_.end(),
+            [](const pointer_map_entry& lhs, const pointer_map_entry& rhs) {
+                return (lhs.value != rhs.value) ? (lhs.value < rhs.value) : (lhs.location < rhs.location);
+            });
+
+        result.entries_.shrink_to_fit();
+
+        return result;
+    }
+
+    inline pointer_map pointer_map::build(const data_accessor& accessor, prot_flags flags)
+    {
+        const region_set regions = mapped_regions(accessor, flags);
+
+        return build(accessor, regions, regions);
+    }
+
+    inline region_set pointer_map::mapped_regions(const data_accessor& accessor, prot_flags flags)
+    {
+        region_set result;
+
+        // One pass over the whole address space, instead of a query per mapping. A failed query still leaves
+        // the regions found before it.
+        std::vector<region_info> regions;
+        accessor.query_regions(nullptr, SIZE_MAX, regions);
+
+        for (const region_info& info : regions)
+        {
+            if ((info.flags & flags) == flags && !(info.flags & prot_flags::G))
+                result.insert(region(info.start, info.size));
+        }
+
+        return result;
+    }
+
+    inline slice<const pointer_map_entry> pointer_map::pointing_into(region range) const noexcept
+    {
+        const std::uintptr_t start = range.start.as<std::uintptr_t>();
+        const std::uintptr_t end = start + range.size;
+
+        const auto first = std::lower_bound(entries_.begin(), entries_.end(), start,
+            [](const pointer_map_entry& lhs, std::uintptr_t rhs) { return lhs.value < rhs; });
+
+        const auto last = std::lower_bound(first, entries_.end(), end,
+            [](const pointer_map_entry& lhs, std::uintptr_t rhs) { return lhs.value < rhs; });
+
+        return {entries_.data() + (first - entries_.begin()), static_cast<std::size_t>(last - first)};
+    }
+
+    inline std::vector<pointer_path> pointer_map::find_paths(pointer target, const region_set& roots,
+        std::size_t max_depth, std::size_t max_offset, std::size_t max_results) const
+    {
+        struct node
+        {
+            std::uintptr_t address;
+            std::size_t parent;
+            std::size_t offset;
+        };
+
+        std::vector<pointer_path> results;
+
+        // Every address reached, with its parent closer to the target
+        std::vector<node> nodes {{target.as<std::uintptr_t>(), SIZE_MAX, 0}};
+        std::unordered_set<std::uintptr_t> visited {target.as<std::uintptr_t>()};
+
+        std::size_t level_begin = 0;
+
+        for (std::size_t depth = 0; depth < max_depth; ++depth)
+        {
+            const std::size_t level_end = nodes.size();
+
+            for (std::size_t i = level_begin; i < level_end; ++i)
+            {
+                const std::uintptr_t address = nodes[i].address;
+                const std::uintptr_t lowest = (address > max_offset) ? address - max_offset : 0;
+
+                for (const pointer_map_entry& entry : pointing_into(region(lowest, address - lowest + 1)))
+                {
+                    if (!visited.insert(entry.location).second)
+                        continue;
+
+                    nodes.push_back({entry.location, i, address - entry.value});
+
+                    if (!roots.contains(entry.location))
+                        continue;
+
+                    pointer_path path;
+                    path.base = entry.location;
+
+                    for (std::size_t j = nodes.size() - 1; nodes[j].parent != SIZE_MAX; j = nodes[j].parent)
+                        path.offsets.push_back(nodes[j].offset);
+
+                    results.push_back(std::move(path));
+
+                    if (results.size() >= max_results)
+                        return results;
+                }
+            }
+
+            level_begin = level_end;
+        }
+
+        return results;
+    }
+
+    MEM_STRONG_INLINE std::size_t pointer_map::size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    MEM_STRONG_INLINE bool pointer_map::empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    MEM_STRONG_INLINE const pointer_map_entry* pointer_map::begin() const noexcept
+    {
+        return entries_.data();
+    }
+
+    MEM_STRONG_INLINE const pointer_map_entry* pointer_map::end() const noexcept
+    {
+        return entries_.data() + entries_.size();
+    }
+
+    inline pointer resolve(const pointer_path& path, const data_accessor& accessor)
+    {
+        std::uintptr_t current = path.base.as<std::uintptr_t>();
+
+        for (std::size_t offset : path.offsets)
+        {
+            std::uintptr_t value = 0;
+
+            if (!accessor.read(reinterpret_cast<void*>(current), &value, sizeof(value)))
+                return nullptr;
+
+            current = value + offset;
+        }
+
+        return current;
+    }
+} // namespace mem
+
+#endif // MEM_POINTER_MAP_BRICK_H
@@ -22,12 +22,28 @@
 
 #include <cstdint>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 #include <mem/memory/prot_flags.h>
+#include <mem/memory/region_set.h>
 
 namespace mem
 {
     constexpr auto scan_default_block_size = 512 * 1024;
+
+    enum class scan_residency
+    {
+        all,      // Read every page, faulting in any which are not resident
+        resident, // Skip pages which are not resident, such as untouched, swapped out or uncached file pages
+    };
+
+    struct scan_stats
+    {
+        std::size_t bytes_skipped {0};    // Not resident, so never read
+        std::size_t bytes_unreadable {0}; // Mapped, but the accessor could not read them
+    };
+
     struct scan_config
     {
         void* start;
@@ -35,7 +51,16 @@ namespace mem
         prot_flags flags = prot_flags::NONE;
         std::size_t block_size = 0;
 
-        constexpr scan_config(prot_flags flags_, void* start_ = nullptr,
+        // When not empty, only these addresses are scanned
+        region_set ranges {};
+
+        // Falls back to reading everything when the accessor cannot tell which pages are resident
+        scan_residency residency = scan_residency::all;
+
+        // When set, the counters of each scan are added to it
+        scan_stats* stats = nullptr;
+
+        inline scan_config(prot_flags flags_, void* start_ = nullptr,
             void* end_ = reinterpret_cast<void*>(std::numeric_limits<std::uintptr_t>::max()),
             std::size_t block_size_ = scan_default_block_size)
             : start(start_)
@@ -52,7 +77,7 @@ namespace mem
             , block_size(block_size_)
         {}
 
-        constexpr scan_config(void* start_,
+        inline scan_config(void* start_,
             void* end_ = reinterpret_cast<void*>(std::numeric_limits<std::uintptr_t>::max()),
             prot_flags flags_ = prot_flags::RW, std::size_t block_size_ = scan_default_block_size)
             : start(start_)
@@ -60,6 +85,15 @@ namespace mem
             , flags(flags_)
             , block_size(block_size_)
         {}
+
+        inline scan_config(region_set ranges_, prot_flags flags_ = prot_flags::RW,
+            std::size_t block_size_ = scan_default_block_size)
+            : start(nullptr)
+            , end(reinterpret_cast<void*>(std::numeric_limits<std::uintptr_t>::max()))
+            , flags(flags_)
+            , block_size(block_size_)
+            , ranges(std::move(ranges_))
+        {}
     };
 
     template <typename ScanConfig>
@@ -0,0 +1,494 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_SIGNATURE_FILE_BRICK_H
+#define MEM_SIGNATURE_FILE_BRICK_H
+
+#include <mem/containers/char_queue.h>
+#include <mem/scanning/pattern.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#    if !defined(WIN32_LEAN_AND_MEAN)
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <Windows.h>
+#elif defined(__unix__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#else
+#    error Unknown Platform
+#endif
+
+namespace mem
+{
+    struct signature
+    {
+        // Null terminated, and empty for unnamed signatures
+        const char* name {""};
+
+        pattern_view pattern {};
+
+        // Line of the file it was read from, starting at 1
+        std::size_t line {0};
+    };
+
+    // Signatures read from text with one per line, such as
+    //
+    //     name = 48 8B 05 ? ? ? ? E8 ?? ?? ?? ??
+    //
+    // The name is optional. A token is two hex digits, either of which can be a ? wildcard, or a single ?.
+    // Blank lines and lines starting with #, ; or // are skipped.
+    //
+    // Names, bytes and masks all live in one arena owned by the file, which the pattern views point into.
+    class signature_file
+    {
+    private:
+        std::vector<byte> arena_ {};
+        std::vector<signature> signatures_ {};
+
+        // Indices of the named signatures, sorted by name
+        std::vector<std::uint32_t> by_name_ {};
+
+        std::size_t error_line_ {0};
+        bool loaded_ {false};
+
+        // Appends the name, bytes and masks of a line to the arena, setting size to 0 for lines without a signature
+        bool parse_line(const char* current, const char* end, std::vector<byte>& masks, std::size_t& name_offset,
+            std::size_t& bytes_offset, std::size_t& size);
+
+    public:
+        using iterator = std::vector<signature>::const_iterator;
+
+        signature_file() = default;
+
+        signature_file(signature_file&& rhs) noexcept = default;
+        signature_file& operator=(signature_file&& rhs) noexcept = default;
+
+        signature_file(const signature_file&) = delete;
+        signature_file& operator=(const signature_file&) = delete;
+
+        static signature_file parse(const char* text, std::size_t length);
+
+        // Maps the file into memory for parsing. Only the arena is kept afterwards.
+        static signature_file load(const char* path);
+
+        // Whether the text was read and every line was valid
+        explicit operator bool() const noexcept;
+
+        // Line of the first invalid signature, or 0. Invalid lines are skipped.
+        std::size_t error_line() const noexcept;
+
+        const signature* find(const char* name) const;
+
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        const signature& operator[](std::size_t index) const noexcept;
+
+        iterator begin() const noexcept;
+        iterator end() const noexcept;
+    };
+
+    namespace internal
+    {
+        // A read only view of a whole file
+        class mapped_file
+        {
+        private:
+            const char* data_ {nullptr};
+            std::size_t size_ {0};
+            bool opened_ {false};
+
+#if defined(_WIN32)
+            HANDLE mapping_ {nullptr};
+#endif
+
+        public:
+            explicit mapped_file(const char* path);
+            ~mapped_file();
+
+            mapped_file(const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+
+            explicit operator bool() const noexcept;
+
+            const char* data() const noexcept;
+            std::size_t size() const noexcept;
+        };
+
+#if defined(_WIN32)
+        inline mapped_file::mapped_file(const char* path)
+        {
+            HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+            if (file == INVALID_HANDLE_VALUE)
+                return;
+
+            LARGE_INTEGER file_size {};
+
+            if (GetFileSizeEx(file, &file_size))
+            {
+                size_ = static_cast<std::size_t>(file_size.QuadPart);
+                opened_ = true;
+
+                // Empty files cannot be mapped
+                if (size_)
+                {
+                    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+                    if (mapping_)
+                        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+
+                    opened_ = data_ != nullptr;
+                }
+            }
+
+            CloseHandle(file);
+        }
+
+        inline mapped_file::~mapped_file()
+        {
+            if (data_)
+                UnmapViewOfFile(data_);
+
+            if (mapping_)
+                CloseHandle(mapping_);
+        }
+#elif defined(__unix__)
+        inline mapped_file::mapped_file(const char* path)
+        {
+            const int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+            if (fd == -1)
+                return;
+
+            struct stat info;
+
+            if (!fstat(fd, &info))
+            {
+                size_ = static_cast<std::size_t>(info.st_size);
+                opened_ = true;
+
+                // Empty files cannot be mapped
+                if (size_)
+                {
+                    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                    if (data != MAP_FAILED)
+                    {
+                        madvise(data, size_, MADV_SEQUENTIAL);
+                        data_ = static_cast<const char*>(data);
+                    }
+
+                    opened_ = data_ != nullptr;
+                }
+            }
+
+            close(fd);
+        }
+
+        inline mapped_file::~mapped_file()
+        {
+            if (data_)
+                munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+
+        MEM_STRONG_INLINE mapped_file::operator bool() const noexcept
+        {
+            return opened_;
+        }
+
+        MEM_STRONG_INLINE const char* mapped_file::data() const noexcept
+        {
+            return data_;
+        }
+
+        MEM_STRONG_INLINE std::size_t mapped_file::size() const noexcept
+        {
+            return size_;
+        }
+
+        // Hex digit values, 0x10 for a ? wildcard, and 0xFF for anything else
+        struct nibble_table
+        {
+            byte values[256] {};
+
+            constexpr nibble_table() noexcept
+            {
+                for (std::size_t i = 0; i < 256; ++i)
+                {
+                    const int digit = xctoi(static_cast<int>(i));
+
+                    values[i] = (digit != -1) ? static_cast<byte>(digit) : (i == '?') ? 0x10 : 0xFF;
+                }
+            }
+        };
+
+        static constexpr nibble_table signature_nibbles {};
+
+        MEM_STRONG_INLINE bool is_blank(char value) noexcept
+        {
+            return (value == ' ') || (value == '\t') || (value == '\r');
+        }
+    } // namespace internal
+
+    inline bool signature_file::parse_line(const char* current, const char* end, std::vector<byte>& masks,
+        std::size_t& name_offset, std::size_t& bytes_offset, std::size_t& size)
+    {
+        size = 0;
+        name_offset = SIZE_MAX;
+
+        while ((current < end) && internal::is_blank(*current))
+            ++current;
+
+        while ((current < end) && internal::is_blank(end[-1]))
+            --end;
+
+        if ((current == end) || (*current == '#') || (*current == ';') ||
+            ((end - current >= 2) && (current[0] == '/') && (current[1] == '/')))
+            return true;
+
+        if (const char* equals = static_cast<const char*>(std::memchr(current, '=', std::size_t(end - current))))
+        {
+            const char* name_end = equals;
+
+            while ((name_end > current) && internal::is_blank(name_end[-1]))
+                --name_end;
+
+            if (name_end == current)
+                return false;
+
+            name_offset = arena_.size();
+            arena_.insert(arena_.end(), current, name_end);
+            arena_.push_back('\0');
+
+            current = equals + 1;
+        }
+
+        // Tokens are separated by blanks, so there are at most half as many as characters
+        const std::size_t max_count = (static_cast<std::size_t>(end - current) + 1) / 2;
+
+        bytes_offset = arena_.size();
+
+        arena_.resize(bytes_offset + max_count);
+        masks.resize(max_count);
+
+        byte* const bytes = &arena_[bytes_offset];
+
+        std::size_t count = 0;
+
+        while (true)
+        {
+            while ((current < end) && internal::is_blank(*current))
+                ++current;
+
+            if (current == end)
+                break;
+
+            const char* token = current;
+
+            while ((current < end) && !internal::is_blank(*current))
+                ++current;
+
+            const std::size_t length = static_cast<std::size_t>(current - token);
+
+            byte value = 0x00;
+            byte mask = 0x00;
+
+            if (length == 2)
+            {
+                const byte high = internal::signature_nibbles.values[static_cast<byte>(token[0])];
+                const byte low = internal::signature_nibbles.values[static_cast<byte>(token[1])];
+
+                if ((high | low) & 0x80)
+                    return false;
+
+                // Wildcard nibbles are 0x10, which shifts out of the mask
+                value = static_cast<byte>(((high & 0x0F) << 4) | (low & 0x0F));
+                mask = static_cast<byte>(((high & 0x10) ? 0x00 : 0xF0) | ((low & 0x10) ? 0x00 : 0x0F));
+            }
+            else if ((length != 1) || (token[0] != '?'))
+            {
+                return false;
+            }
+
+            bytes[count] = value & mask;
+            masks[count] = mask;
+            ++count;
+        }
+
+        if (!count)
+            return false;
+
+        arena_.resize(bytes_offset + count);
+        arena_.insert(arena_.end(), masks.begin(), masks.begin() + static_cast<std::ptrdiff_t>(count));
+        size = count;
+
+        return true;
+    }
+
+    inline signature_file signature_file::parse(const char* text, std::size_t length)
+    {
+        struct offsets
+        {
+            std::size_t name;
+            std::size_t bytes;
+            std::size_t size;
+            std::size_t line;
+        };
+
+        signature_file result;
+
+        result.loaded_ = true;
+
+        // A name or a token never takes more arena space than twice its text
+        result.arena_.reserve(length * 2);
+
+        // The arena can still move while parsing, so views are only made once it is complete
+        std::vector<offsets> pending;
+        std::vector<byte> masks;
+
+        std::size_t line = 0;
+
+        for (const char* current = text, *const end = text + length; current < end;)
+        {
+            const char* line_end = static_cast<const char*>(std::memchr(current, '\n', std::size_t(end - current)));
+
+            if (!line_end)
+                line_end = end;
+
+            ++line;
+
+            const std::size_t arena_size = result.arena_.size();
+
+            offsets entry {SIZE_MAX, 0, 0, line};
+
+            if (!result.parse_line(current, line_end, masks, entry.name, entry.bytes, entry.size))
+            {
+                result.arena_.resize(arena_size);
+
+                if (!result.error_line_)
+                    result.error_line_ = line;
+            }
+            else if (entry.size)
+            {
+                pending.push_back(entry);
+            }
+
+            current = line_end + 1;
+        }
+
+        result.arena_.shrink_to_fit();
+        result.signatures_.reserve(pending.size());
+
+        const byte* const arena = result.arena_.data();
+
+        for (const offsets& entry : pending)
+        {
+            signature value;
+
+            if (entry.name != SIZE_MAX)
+            {
+                value.name = reinterpret_cast<const char*>(arena + entry.name);
+                result.by_name_.push_back(static_cast<std::uint32_t>(result.signatures_.size()));
+            }
+
+            value.pattern = pattern_view(arena + entry.bytes, arena + entry.bytes + entry.size, entry.size);
+            value.line = entry.line;
+
+            result.signatures_.push_back(value);
+        }
+
+        const std::vector<signature>& signatures = result.signatures_;
+
+        std::stable_sort(
+            result.by_name_.begin(), result.by_name_.end(), [&signatures](std::uint32_t lhs, std::uint32_t rhs) {
+                return std::strcmp(signatures[lhs].name, signatures[rhs].name) < 0;
+            });
+
+        return result;
+    }
+
+    inline signature_file signature_file::load(const char* path)
+    {
+        internal::mapped_file file(path);
+
+        if (!file)
+            return {};
+
+        return parse(file.data(), file.size());
+    }
+
+    MEM_STRONG_INLINE signature_file::operator bool() const noexcept
+    {
+        return loaded_ && !error_line_;
+    }
+
+    MEM_STRONG_INLINE std::size_t signature_file::error_line() const noexcept
+    {
+        return error_line_;
+    }
+
+    inline const signature* signature_file::find(const char* name) const
+    {
+        const auto iter = std::lower_bound(by_name_.begin(), by_name_.end(), name,
+            [this](std::uint32_t lhs, const char* rhs) { return std::strcmp(signatures_[lhs].name, rhs) < 0; });
+
+        if ((iter == by_name_.end()) || std::strcmp(signatures_[*iter].name, name))
+            return nullptr;
+
+        return &signatures_[*iter];
+    }
+
+    MEM_STRONG_INLINE std::size_t signature_file::size() const noexcept
+    {
+        return signatures_.size();
+    }
+
+    MEM_STRONG_INLINE bool signature_file::empty() const noexcept
+    {
+        return signatures_.empty();
+    }
+
+    MEM_STRONG_INLINE const signature& signature_file::operator[](std::size_t index) const noexcept
+    {
+        return signatures_[index];
+    }
+
+    MEM_STRONG_INLINE signature_file::iterator signature_file::begin() const noexcept
+    {
+        return signatures_.begin();
+    }
+
+    MEM_STRONG_INLINE signature_file::iterator signature_file::end() const noexcept
+    {
+        return signatures_.end();
+    }
+} // namespace mem
+
+#endif // MEM_SIGNATURE_FILE_BRICK_H
@@ -0,0 +1,456 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_SIGNATURE_PACK_BRICK_H
+#define MEM_SIGNATURE_PACK_BRICK_H
+
+#include <mem/scanning/auto_scanner.h>
+#include <mem/scanning/boyer_moore_scanner.h>
+#include <mem/scanning/signature_file.h>
+#include <mem/scanning/simd_scanner.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace mem
+{
+    namespace internal
+    {
+        // All offsets are from the start of the pack, and values are in the byte order of the compiler
+        struct pack_header
+        {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t entry_size;
+            std::uint32_t count;
+            std::uint32_t entries;
+            std::uint32_t by_name; // Indices of the named entries, sorted by name
+            std::uint32_t named;
+            std::uint32_t size;
+        };
+
+        struct pack_entry
+        {
+            std::uint32_t name; // Null terminated
+            std::uint32_t name_size;
+            std::uint32_t line;
+
+            std::uint32_t bytes; // Followed by the masks
+            std::uint32_t size;
+            std::uint32_t trimmed_size;
+            std::uint32_t flags;
+
+            std::uint32_t simd_skip_pos;
+
+            std::uint32_t bm_skip_pos;
+            std::uint32_t bm_max_skip;
+            std::uint32_t bm_qgram_size;
+            std::uint32_t bm_skips;    // 0 when the scanner has no table
+            std::uint32_t gs_skips;    // 0 when the scanner has no table
+            std::uint32_t qgram_skips; // 0 when the scanner has no table
+        };
+
+        static constexpr std::uint32_t pack_needs_masks {0x1};
+    } // namespace internal
+
+    // Signatures stored together with everything their scanners precompute, so loading only has to check the
+    // layout before handing out scanners which point straight into the pack.
+    //
+    // The format is versioned and not portable between byte orders. Packs are rejected by load when either
+    // differs, or when the scanners change how they build their tables, and should then be compiled again.
+    class signature_pack
+    {
+    private:
+        std::unique_ptr<internal::mapped_file> file_ {};
+
+        const byte* data_ {nullptr};
+        const internal::pack_entry* entries_ {nullptr};
+        const std::uint32_t* by_name_ {nullptr};
+
+        std::size_t count_ {0};
+        std::size_t named_ {0};
+
+        const internal::pack_entry& entry(std::size_t index) const noexcept;
+
+        // Checks every offset, size and skip of an entry which the scanners rely on
+        static bool check_entry(const byte* data, std::size_t size, const internal::pack_entry& entry) noexcept;
+
+    public:
+        static constexpr const std::uint32_t magic {0x4B50534D}; // "MSPK"
+        static constexpr const std::uint16_t version {1};
+
+        signature_pack() = default;
+
+        // Returns an empty vector if the pack would not fit in 4 GiB
+        static std::vector<byte> compile(const signature_file& signatures);
+
+        static bool compile(const signature_file& signatures, std::ostream& output);
+
+        // Compiles a text signature file, failing if any line of it is invalid
+        static bool compile(const char* signatures_path, const char* pack_path);
+
+        // Uses a pack already in memory, which must be 4 byte aligned and outlive the result
+        static signature_pack view(const void* data, std::size_t size);
+
+        // Maps the pack into memory, keeping it mapped for the lifetime of the result
+        static signature_pack load(const char* path);
+
+        // Whether the pack was loaded and valid
+        explicit operator bool() const noexcept;
+
+        // Index of the signature with a name, or SIZE_MAX
+        std::size_t find(const char* name) const noexcept;
+
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        signature operator[](std::size_t index) const noexcept;
+
+        const char* name(std::size_t index) const noexcept;
+        pattern_view pattern(std::size_t index) const noexcept;
+
+        simd_scanner simd(std::size_t index) const noexcept;
+        boyer_moore_scanner boyer_moore(std::size_t index) const noexcept;
+        auto_scanner scanner(std::size_t index) const;
+    };
+
+    inline std::vector<byte> signature_pack::compile(const signature_file& signatures)
+    {
+        using internal::pack_entry;
+        using internal::pack_header;
+
+        const std::size_t count = signatures.size();
+
+        std::vector<std::uint32_t> by_name;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (*signatures[i].name)
+                by_name.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        std::sort(by_name.begin(), by_name.end(), [&signatures](std::uint32_t lhs, std::uint32_t rhs) {
+            const int order = std::strcmp(signatures[lhs].name, signatures[rhs].name);
+
+            return (order != 0) ? (order < 0) : (lhs < rhs);
+        });
+
+        std::vector<pack_entry> entries(count);
+        std::vector<byte> result(sizeof(pack_header) + sizeof(pack_entry) * count);
+
+        const auto append = [&result](const void* data, std::size_t size, std::size_t alignment) {
+            result.resize((result.size() + alignment - 1) & ~(alignment - 1));
+
+            const std::size_t offset = result.size();
+            result.insert(result.end(), static_cast<const byte*>(data), static_cast<const byte*>(data) + size);
+
+            return static_cast<std::uint32_t>(offset);
+        };
+
+        const auto narrow = [](std::size_t value) {
+            return (value != SIZE_MAX) ? static_cast<std::uint32_t>(value) : UINT32_MAX;
+        };
+
+        const std::uint32_t by_name_offset = append(by_name.data(), by_name.size() * sizeof(std::uint32_t), 4);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const signature& value = signatures[i];
+            const pattern_view pattern = value.pattern;
+
+            pack_entry& entry = entries[i];
+
+            entry.name_size = static_cast<std::uint32_t>(std::strlen(value.name));
+            entry.name = append(value.name, entry.name_size + 1, 1);
+            entry.line = static_cast<std::uint32_t>(value.line);
+
+            entry.size = static_cast<std::uint32_t>(pattern.size());
+            entry.trimmed_size = static_cast<std::uint32_t>(pattern.trimmed_size());
+            entry.flags = pattern.needs_masks() ? internal::pack_needs_masks : 0;
+            entry.bytes = append(pattern.bytes(), pattern.size(), 1);
+            append(pattern.masks(), pattern.size(), 1);
+
+            entry.simd_skip_pos = narrow(simd_scanner(pattern).skip_pos());
+
+            const boyer_moore_scanner scanner(pattern);
+            const boyer_moore_tables tables = scanner.tables();
+
+            entry.bm_skip_pos = narrow(tables.skip_pos);
+            entry.bm_max_skip = static_cast<std::uint32_t>(tables.max_skip);
+            entry.bm_qgram_size = static_cast<std::uint32_t>(tables.qgram_size);
+
+            entry.bm_skips = tables.bc_skips ? append(tables.bc_skips, 256, 1) : 0;
+            entry.gs_skips =
+                tables.gs_skips ? append(tables.gs_skips, pattern.trimmed_size() * sizeof(std::uint16_t), 2) : 0;
+            entry.qgram_skips =
+                tables.qgram_skips ? append(tables.qgram_skips, boyer_moore_scanner::qgram_table_size, 1) : 0;
+
+            if (result.size() > UINT32_MAX)
+                return {};
+        }
+
+        result.resize((result.size() + 3) & ~std::size_t(3));
+
+        if (result.size() > UINT32_MAX)
+            return {};
+
+        pack_header header;
+        header.magic = magic;
+        header.version = version;
+        header.entry_size = sizeof(pack_entry);
+        header.count = static_cast<std::uint32_t>(count);
+        header.entries = sizeof(pack_header);
+        header.by_name = by_name_offset;
+        header.named = static_cast<std::uint32_t>(by_name.size());
+        header.size = static_cast<std::uint32_t>(result.size());
+
+        std::memcpy(result.data(), &header, sizeof(header));
+
+        if (count)
+            std::memcpy(result.data() + sizeof(header), entries.data(), sizeof(pack_entry) * count);
+
+        return result;
+    }
+
+    inline bool signature_pack::compile(const signature_file& signatures, std::ostream& output)
+    {
+        const std::vector<byte> pack = compile(signatures);
+
+        if (pack.empty())
+            return false;
+
+        output.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+
+        return output.good();
+    }
+
+    inline bool signature_pack::compile(const char* signatures_path, const char* pack_path)
+    {
+        const signature_file signatures = signature_file::load(signatures_path);
+
+        if (!signatures)
+            return false;
+
+        std::ofstream output(pack_path, std::ios::binary | std::ios::trunc);
+
+        return output && compile(signatures, output);
+    }
+
+    inline bool signature_pack::check_entry(
+        const byte* data, std::size_t size, const internal::pack_entry& entry) noexcept
+    {
+        const auto fits = [size](std::uint32_t offset, std::size_t length) {
+            return (offset <= size) && (length <= size - offset);
+        };
+
+        const std::size_t trimmed_size = entry.trimmed_size;
+
+        if (!fits(entry.name, std::size_t(entry.name_size) + 1) || data[entry.name + entry.name_size])
+            return false;
+
+        if (!entry.size || (trimmed_size > entry.size) || !fits(entry.bytes, std::size_t(entry.size) * 2))
+            return false;
+
+        const byte* const masks = data + entry.bytes + entry.size;
+
+        // The anchor is searched for directly, so it has to be a whole byte
+        if ((entry.simd_skip_pos != UINT32_MAX) && ((entry.simd_skip_pos >= trimmed_size) ||
+                                                       (masks[entry.simd_skip_pos] != 0xFF)))
+            return false;
+
+        if (entry.bm_qgram_size)
+        {
+            if ((entry.bm_qgram_size != 2 && entry.bm_qgram_size != 3) || !entry.qgram_skips ||
+                !fits(entry.qgram_skips, boyer_moore_scanner::qgram_table_size) ||
+                (std::size_t(entry.bm_skip_pos) + entry.bm_qgram_size > trimmed_size))
+                return false;
+        }
+        else if (entry.qgram_skips)
+        {
+            return false;
+        }
+
+        if (entry.bm_skips && (!fits(entry.bm_skips, 256) || (entry.bm_skip_pos >= trimmed_size)))
+            return false;
+
+        if (entry.gs_skips)
+        {
+            if (!entry.bm_skips || (entry.gs_skips & 1) ||
+                !fits(entry.gs_skips, trimmed_size * sizeof(std::uint16_t)))
+                return false;
+
+            const std::uint16_t* const skips = reinterpret_cast<const std::uint16_t*>(data + entry.gs_skips);
+
+            // Each shift has to move past the mismatch, or the scan would never finish
+            for (std::size_t i = 0; i < trimmed_size; ++i)
+            {
+                if (skips[i] < trimmed_size - i)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline signature_pack signature_pack::view(const void* data, std::size_t size)
+    {
+        using internal::pack_entry;
+        using internal::pack_header;
+
+        signature_pack result;
+
+        const byte* const bytes = static_cast<const byte*>(data);
+
+        if (!bytes || (size < sizeof(pack_header)) || (reinterpret_cast<std::uintptr_t>(bytes) & 3))
+            return result;
+
+        const pack_header& header = *reinterpret_cast<const pack_header*>(bytes);
+
+        if ((header.magic != magic) || (header.version != version) || (header.entry_size != sizeof(pack_entry)) ||
+            (header.size != size) || (header.entries & 3) || (header.by_name & 3))
+            return result;
+
+        if ((header.entries > size) || (header.count > (size - header.entries) / sizeof(pack_entry)) ||
+            (header.by_name > size) || (header.named > (size - header.by_name) / sizeof(std::uint32_t)) ||
+            (header.named > header.count))
+            return result;
+
+        const pack_entry* const entries = reinterpret_cast<const pack_entry*>(bytes + header.entries);
+        const std::uint32_t* const by_name = reinterpret_cast<const std::uint32_t*>(bytes + header.by_name);
+
+        for (std::size_t i = 0; i < header.count; ++i)
+        {
+            if (!check_entry(bytes, size, entries[i]))
+                return result;
+        }
+
+        for (std::size_t i = 0; i < header.named; ++i)
+        {
+            if (by_name[i] >= header.count)
+                return result;
+        }
+
+        result.data_ = bytes;
+        result.entries_ = entries;
+        result.by_name_ = by_name;
+        result.count_ = header.count;
+        result.named_ = header.named;
+
+        return result;
+    }
+
+    inline signature_pack signature_pack::load(const char* path)
+    {
+        std::unique_ptr<internal::mapped_file> file(new internal::mapped_file(path));
+
+        if (!*file)
+            return {};
+
+        signature_pack result = view(file->data(), file->size());
+
+        if (result)
+            result.file_ = std::move(file);
+
+        return result;
+    }
+
+    MEM_STRONG_INLINE signature_pack::operator bool() const noexcept
+    {
+        return data_ != nullptr;
+    }
+
+    MEM_STRONG_INLINE const internal::pack_entry& signature_pack::entry(std::size_t index) const noexcept
+    {
+        return entries_[index];
+    }
+
+    inline std::size_t signature_pack::find(const char* _name) const noexcept
+    {
+        const std::uint32_t* const first = std::lower_bound(by_name_, by_name_ + named_, _name,
+            [this](std::uint32_t lhs, const char* rhs) { return std::strcmp(name(lhs), rhs) < 0; });
+
+        if ((first != by_name_ + named_) && !std::strcmp(name(*first), _name))
+            return *first;
+
+        return SIZE_MAX;
+    }
+
+    MEM_STRONG_INLINE std::size_t signature_pack::size() const noexcept
+    {
+        return count_;
+    }
+
+    MEM_STRONG_INLINE bool signature_pack::empty() const noexcept
+    {
+        return !count_;
+    }
+
+    MEM_STRONG_INLINE signature signature_pack::operator[](std::size_t index) const noexcept
+    {
+        return {name(index), pattern(index), entry(index).line};
+    }
+
+    MEM_STRONG_INLINE const char* signature_pack::name(std::size_t index) const noexcept
+    {
+        return reinterpret_cast<const char*>(data_ + entry(index).name);
+    }
+
+    MEM_STRONG_INLINE pattern_view signature_pack::pattern(std::size_t index) const noexcept
+    {
+        const internal::pack_entry& value = entry(index);
+
+        return pattern_view(data_ + value.bytes, data_ + value.bytes + value.size, value.size, value.trimmed_size,
+            (value.flags & internal::pack_needs_masks) != 0);
+    }
+
+    MEM_STRONG_INLINE simd_scanner signature_pack::simd(std::size_t index) const noexcept
+    {
+        const std::uint32_t skip_pos = entry(index).simd_skip_pos;
+
+        return simd_scanner(pattern(index), (skip_pos != UINT32_MAX) ? skip_pos : SIZE_MAX);
+    }
+
+    inline boyer_moore_scanner signature_pack::boyer_moore(std::size_t index) const noexcept
+    {
+        const internal::pack_entry& value = entry(index);
+
+        boyer_moore_tables tables;
+
+        tables.bc_skips = value.bm_skips ? data_ + value.bm_skips : nullptr;
+        tables.gs_skips = value.gs_skips ? reinterpret_cast<const std::uint16_t*>(data_ + value.gs_skips) : nullptr;
+        tables.qgram_skips = value.qgram_skips ? data_ + value.qgram_skips : nullptr;
+        tables.qgram_size = value.bm_qgram_size;
+        tables.skip_pos = (value.bm_skip_pos != UINT32_MAX) ? value.bm_skip_pos : SIZE_MAX;
+        tables.max_skip = value.bm_max_skip;
+
+        return boyer_moore_scanner(pattern(index), tables);
+    }
+
+    inline auto_scanner signature_pack::scanner(std::size_t index) const
+    {
+        return auto_scanner(simd(index), boyer_moore(index));
+    }
+} // namespace mem
+
+#endif // MEM_SIGNATURE_PACK_BRICK_H
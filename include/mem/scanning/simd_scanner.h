@@ -46,25 +46,45 @@ namespace mem
     public:
         simd_scanner() = default;
 
-        simd_scanner(const pattern& pattern);
-        simd_scanner(const pattern& pattern, const byte* frequencies);
+        simd_scanner(pattern_view pattern);
+        simd_scanner(pattern_view pattern, const byte* frequencies);
+
+        // Uses an anchor chosen earlier by get_skip_pos, or SIZE_MAX for none
+        simd_scanner(pattern_view pattern, std::size_t skip_pos) noexcept;
 
         pointer scan(region range) const;
 
+        using scanner_base<simd_scanner>::scan_all;
+
+        template <typename Func>
+        pointer scan_all(region range, Func func) const;
+
+        std::size_t skip_pos() const noexcept;
+
         static const byte* default_frequencies() noexcept;
     };
 
     const byte* find_byte(const byte* ptr, byte value, std::size_t num);
 
-    inline simd_scanner::simd_scanner(const pattern& _pattern)
+    inline simd_scanner::simd_scanner(pattern_view _pattern)
         : simd_scanner(_pattern, default_frequencies())
     {}
 
-    inline simd_scanner::simd_scanner(const pattern& _pattern, const byte* frequencies)
+    inline simd_scanner::simd_scanner(pattern_view _pattern, const byte* frequencies)
         : scanner_base<simd_scanner>(_pattern)
         , skip_pos_(_pattern.get_skip_pos(frequencies))
     {}
 
+    inline simd_scanner::simd_scanner(pattern_view _pattern, std::size_t skip_pos) noexcept
+        : scanner_base<simd_scanner>(_pattern)
+        , skip_pos_(skip_pos)
+    {}
+
+    MEM_STRONG_INLINE std::size_t simd_scanner::skip_pos() const noexcept
+    {
+        return skip_pos_;
+    }
+
     MEM_STRONG_INLINE const byte* simd_scanner::default_frequencies() noexcept
     {
         // clang-format off
@@ -92,14 +112,20 @@ namespace mem
         return frequencies;
     }
 
-    inline pointer simd_scanner::scan(region range) const
+    MEM_STRONG_INLINE pointer simd_scanner::scan(region range) const
     {
-        const std::size_t trimmed_size = pattern_->trimmed_size();
+        return scan_all(range, [](pointer) { return true; });
+    }
+
+    template <typename Func>
+    inline pointer simd_scanner::scan_all(region range, Func func) const
+    {
+        const std::size_t trimmed_size = pattern_.trimmed_size();
 
         if (!trimmed_size)
             return nullptr;
 
-        const std::size_t original_size = pattern_->size();
+        const std::size_t original_size = pattern_.size();
         const std::size_t region_size = range.size;
 
         if (original_size > region_size)
@@ -113,15 +139,15 @@ namespace mem
 
         const std::size_t last = trimmed_size - 1;
 
-        const byte* const pat_bytes = pattern_->bytes();
+        const byte* const pat_bytes = pattern_.bytes();
 
         const std::size_t skip_pos = skip_pos_;
 
         if (skip_pos != SIZE_MAX)
         {
-            if (pattern_->needs_masks())
+            if (pattern_.needs_masks())
             {
-                const byte* const pat_masks = pattern_->masks();
+                const byte* const pat_masks = pattern_.masks();
 
                 while (MEM_LIKELY(current < end))
                 {
@@ -132,7 +158,12 @@ namespace mem
                         [[MEM_ATTR_LIKELY]];
 
                         if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                            return current;
+                        {
+                            if (func(current))
+                                return current;
+
+                            break;
+                        }
                     }
 
                     ++current;
@@ -154,7 +185,12 @@ namespace mem
                         [[MEM_ATTR_LIKELY]];
 
                         if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                            return current;
+                        {
+                            if (func(current))
+                                return current;
+
+                            break;
+                        }
                     }
 
                     ++current;
@@ -168,7 +204,7 @@ namespace mem
         }
         else
         {
-            const byte* const pat_masks = pattern_->masks();
+            const byte* const pat_masks = pattern_.masks();
 
             while (MEM_LIKELY(current < end))
             {
@@ -179,7 +215,12 @@ namespace mem
                     [[MEM_ATTR_LIKELY]];
 
                     if (MEM_UNLIKELY(i == 0)) [[MEM_ATTR_UNLIKELY]]
-                        return current;
+                    {
+                        if (func(current))
+                            return current;
+
+                        break;
+                    }
                 }
 
                 ++current;
@@ -0,0 +1,484 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_STRING_SCANNER_BRICK_H
+#define MEM_STRING_SCANNER_BRICK_H
+
+#include <mem/memory/region.h>
+#include <mem/scanning/auto_scanner.h>
+#include <mem/utils/bitwise_enum.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(MEM_SIMD_AVX2)
+#    include <immintrin.h>
+#elif defined(MEM_SIMD_SSE2)
+#    include <emmintrin.h>
+#endif
+
+namespace mem
+{
+    namespace enums
+    {
+        enum text_encoding : std::uint32_t
+        {
+            ASCII = 0x1,   // Printable ASCII
+            UTF8 = 0x2,    // Printable ASCII and valid multi-byte sequences
+            UTF16LE = 0x4, // Printable ASCII code units, at either byte alignment
+
+            ANY_ENCODING = ASCII | UTF8 | UTF16LE,
+        };
+
+        MEM_DEFINE_ENUM_FLAG_OPERATORS(text_encoding)
+    } // namespace enums
+
+    using enums::text_encoding;
+
+    struct found_string
+    {
+        region range {};
+        text_encoding encoding {text_encoding::ASCII};
+
+        // Number of characters
+        std::size_t length {0};
+    };
+
+    struct text_options
+    {
+        // Compare ASCII letters case insensitively
+        bool ignore_case {false};
+
+        // ASCII and UTF8 search for the literal bytes. UTF16LE decodes the text as UTF-8 and searches for its UTF-16
+        // code units, taking any byte which is not valid UTF-8 as Latin-1.
+        text_encoding encoding {text_encoding::ASCII};
+    };
+
+    // Calls func(found_string) for each run of at least min_length printable characters, stopping when it returns
+    // true. Single byte and UTF-16LE runs are each reported in address order, but not merged with each other.
+    // Returns whether func stopped the search.
+    template <typename Func>
+    bool find_strings(region range, std::size_t min_length, text_encoding encodings, Func func);
+
+    std::vector<found_string> find_strings(
+        region range, std::size_t min_length = 4, text_encoding encodings = text_encoding::ANY_ENCODING);
+
+    // The pattern matching text, as used by find_text
+    pattern text_pattern(const char* text, const text_options& options = {});
+
+    std::vector<pointer> find_text(region range, const char* text, const text_options& options = {});
+
+    namespace internal
+    {
+        MEM_STRONG_INLINE bool is_printable(byte value) noexcept
+        {
+            return ((value >= 0x20) && (value < 0x7F)) || (value == '\t') || (value == '\n') || (value == '\r');
+        }
+
+        // Length of the UTF-8 sequence at data, which is stored in value, or 0 if it is invalid, overlong or a
+        // surrogate
+        inline std::size_t utf8_decode(const byte* data, std::size_t available, std::uint32_t& value) noexcept
+        {
+            const byte lead = data[0];
+
+            std::size_t length = 0;
+            std::uint32_t lowest = 0;
+
+            if (lead < 0x80)
+            {
+                value = lead;
+                return 1;
+            }
+            else if ((lead & 0xE0) == 0xC0)
+            {
+                length = 2;
+                value = lead & 0x1Fu;
+                lowest = 0x80;
+            }
+            else if ((lead & 0xF0) == 0xE0)
+            {
+                length = 3;
+                value = lead & 0x0Fu;
+                lowest = 0x800;
+            }
+            else if ((lead & 0xF8) == 0xF0)
+            {
+                length = 4;
+                value = lead & 0x07u;
+                lowest = 0x10000;
+            }
+            else
+            {
+                return 0;
+            }
+
+            if (length > available)
+                return 0;
+
+            for (std::size_t i = 1; i < length; ++i)
+            {
+                if ((data[i] & 0xC0) != 0x80)
+                    return 0;
+
+                value = (value << 6) | (data[i] & 0x3Fu);
+            }
+
+            if ((value < lowest) || (value > 0x10FFFF) || ((value >= 0xD800) && (value <= 0xDFFF)))
+                return 0;
+
+            return length;
+        }
+
+        // Length of the printable multibyte UTF-8 sequence at data, or 0 if it is invalid, overlong, a surrogate or
+        // a C1 control
+        inline std::size_t utf8_sequence(const byte* data, std::size_t available) noexcept
+        {
+            std::uint32_t value = 0;
+
+            const std::size_t length = utf8_decode(data, available, value);
+
+            return ((length > 1) && (value >= 0xA0)) ? length : 0;
+        }
+
+        struct string_masks
+        {
+            std::uint32_t printable; // Printable ASCII bytes
+            std::uint32_t high;      // Bytes with the top bit set
+            std::uint32_t next_zero; // Bytes followed by a zero byte
+        };
+
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+        // Classifies data[0, 32), reading data[32] for next_zero
+        MEM_STRONG_INLINE string_masks classify_block(const byte* data) noexcept
+        {
+#    if defined(MEM_SIMD_AVX2)
+            const auto classify = [](const byte* ptr, std::uint32_t& printable, std::uint32_t& high,
+                                      std::uint32_t& next_zero) {
+                const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+                const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + 1));
+
+                // Signed compares, so bytes with the top bit set are below 0x20
+                const __m256i visible = _mm256_and_si256(_mm256_cmpgt_epi8(value, _mm256_set1_epi8(0x1F)),
+                    _mm256_cmpgt_epi8(_mm256_set1_epi8(0x7F), value));
+
+                const __m256i spaces = _mm256_or_si256(_mm256_cmpeq_epi8(value, _mm256_set1_epi8('\t')),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(value, _mm256_set1_epi8('\n')),
+                        _mm256_cmpeq_epi8(value, _mm256_set1_epi8('\r'))));
+
+                printable = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(visible, spaces)));
+                high = static_cast<std::uint32_t>(_mm256_movemask_epi8(value));
+                next_zero =
+                    static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(next, _mm256_setzero_si256())));
+            };
+
+            string_masks result;
+            classify(data, result.printable, result.high, result.next_zero);
+            return result;
+#    else
+            const auto classify = [](const byte* ptr, std::uint32_t& printable, std::uint32_t& high,
+                                      std::uint32_t& next_zero) {
+                const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+                const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 1));
+
+                // Signed compares, so bytes with the top bit set are below 0x20
+                const __m128i visible = _mm_and_si128(
+                    _mm_cmpgt_epi8(value, _mm_set1_epi8(0x1F)), _mm_cmplt_epi8(value, _mm_set1_epi8(0x7F)));
+
+                const __m128i spaces = _mm_or_si128(_mm_cmpeq_epi8(value, _mm_set1_epi8('\t')),
+                    _mm_or_si128(
+                        _mm_cmpeq_epi8(value, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(value, _mm_set1_epi8('\r'))));
+
+                printable = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(visible, spaces)));
+                high = static_cast<std::uint32_t>(_mm_movemask_epi8(value));
+                next_zero = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(next, _mm_setzero_si128())));
+            };
+
+            string_masks lo;
+            string_masks hi;
+
+            classify(data, lo.printable, lo.high, lo.next_zero);
+            classify(data + 16, hi.printable, hi.high, hi.next_zero);
+
+            return {lo.printable | (hi.printable << 16), lo.high | (hi.high << 16),
+                lo.next_zero | (hi.next_zero << 16)};
+#    endif
+        }
+#endif
+    } // namespace internal
+
+    template <typename Func>
+    inline bool find_strings(region range, std::size_t min_length, text_encoding encodings, Func func)
+    {
+        const byte* const data = range.start.as<const byte*>();
+        const std::size_t size = range.size;
+
+        const bool want_ascii = (encodings & text_encoding::ASCII) != 0;
+        const bool want_utf8 = (encodings & text_encoding::UTF8) != 0;
+        const bool want_narrow = want_ascii || want_utf8;
+        const bool want_wide = (encodings & text_encoding::UTF16LE) != 0;
+
+        if (!min_length)
+            min_length = 1;
+
+        bool stopped = false;
+
+        // Single byte (ASCII or UTF-8) run
+        std::size_t narrow_start = 0;
+        std::size_t narrow_length = 0;
+        bool narrow_multibyte = false;
+
+        // Next byte the narrow run still has to look at, which can be past a block after a multi-byte sequence
+        std::size_t narrow_next = 0;
+
+        // UTF-16LE runs starting at even and odd offsets
+        std::size_t wide_start[2] {};
+        std::size_t wide_length[2] {};
+
+        const auto close_narrow = [&](std::size_t end) {
+            if (narrow_length >= min_length)
+            {
+                const text_encoding encoding =
+                    (narrow_multibyte || !want_ascii) ? text_encoding::UTF8 : text_encoding::ASCII;
+
+                stopped = func(found_string {region(data + narrow_start, end - narrow_start), encoding, narrow_length});
+            }
+
+            narrow_length = 0;
+            narrow_multibyte = false;
+        };
+
+        const auto close_wide = [&](std::size_t parity) {
+            if (wide_length[parity] >= min_length)
+            {
+                stopped = func(found_string {region(data + wide_start[parity], wide_length[parity] * 2),
+                    text_encoding::UTF16LE, wide_length[parity]});
+            }
+
+            wide_length[parity] = 0;
+        };
+
+        const auto extend_narrow = [&](std::size_t i, std::size_t count) {
+            if (!narrow_length)
+                narrow_start = i;
+
+            narrow_length += count;
+        };
+
+        const auto step_narrow = [&](std::size_t i) -> std::size_t {
+            if (internal::is_printable(data[i]))
+            {
+                extend_narrow(i, 1);
+                return 1;
+            }
+
+            if (want_utf8 && (data[i] & 0x80))
+            {
+                if (const std::size_t length = internal::utf8_sequence(data + i, size - i))
+                {
+                    extend_narrow(i, 1);
+                    narrow_multibyte = true;
+                    return length;
+                }
+            }
+
+            if (narrow_length)
+                close_narrow(i);
+
+            return 1;
+        };
+
+        const auto step_wide = [&](std::size_t i) {
+            const std::size_t parity = i & 1;
+
+            if ((i + 1 < size) && internal::is_printable(data[i]) && !data[i + 1])
+            {
+                if (!wide_length[parity])
+                    wide_start[parity] = i;
+
+                ++wide_length[parity];
+            }
+            else if (wide_length[parity])
+            {
+                close_wide(parity);
+            }
+        };
+
+        std::size_t i = 0;
+
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+        constexpr std::uint32_t even_units = 0x55555555;
+
+        for (; !stopped && (i + 33 <= size); i += 32)
+        {
+            const internal::string_masks masks = internal::classify_block(data + i);
+
+            if (want_narrow && (narrow_next < i + 32))
+            {
+                if ((narrow_next == i) && (masks.printable == 0xFFFFFFFF))
+                {
+                    extend_narrow(i, 32);
+                    narrow_next = i + 32;
+                }
+                else if ((narrow_next == i) && !(masks.printable | (want_utf8 ? masks.high : 0)))
+                {
+                    if (narrow_length)
+                        close_narrow(i);
+
+                    narrow_next = i + 32;
+                }
+                else
+                {
+                    while (!stopped && (narrow_next < i + 32))
+                        narrow_next += step_narrow(narrow_next);
+                }
+            }
+
+            if (want_wide)
+            {
+                const std::uint32_t units = masks.printable & masks.next_zero;
+
+                for (std::size_t parity = 0; !stopped && (parity < 2); ++parity)
+                {
+                    const std::uint32_t lanes = even_units << parity;
+
+                    if ((units & lanes) == lanes)
+                    {
+                        if (!wide_length[parity])
+                            wide_start[parity] = i + parity;
+
+                        wide_length[parity] += 16;
+                    }
+                    else if (!(units & lanes))
+                    {
+                        if (wide_length[parity])
+                            close_wide(parity);
+                    }
+                    else
+                    {
+                        for (std::size_t j = i + parity; !stopped && (j < i + 32); j += 2)
+                            step_wide(j);
+                    }
+                }
+            }
+        }
+#endif
+
+        if (narrow_next < i)
+            narrow_next = i;
+
+        while (want_narrow && !stopped && (narrow_next < size))
+            narrow_next += step_narrow(narrow_next);
+
+        for (std::size_t j = i; want_wide && !stopped && (j < size); ++j)
+            step_wide(j);
+
+        if (!stopped && want_narrow && narrow_length)
+            close_narrow(size);
+
+        for (std::size_t parity = 0; !stopped && want_wide && (parity < 2); ++parity)
+        {
+            if (wide_length[parity])
+                close_wide(parity);
+        }
+
+        return stopped;
+    }
+
+    inline std::vector<found_string> find_strings(region range, std::size_t min_length, text_encoding encodings)
+    {
+        std::vector<found_string> results;
+
+        find_strings(range, min_length, encodings, [&results](const found_string& result) {
+            results.push_back(result);
+            return false;
+        });
+
+        return results;
+    }
+
+    inline pattern text_pattern(const char* text, const text_options& options)
+    {
+        const byte* const data = reinterpret_cast<const byte*>(text);
+        const std::size_t length = std::strlen(text);
+        const bool utf16 = (options.encoding & text_encoding::UTF16LE) != 0;
+
+        std::vector<byte> bytes;
+        std::vector<byte> masks;
+
+        bytes.reserve(length * 2);
+        masks.reserve(length * 2);
+
+        const auto add = [&](std::uint32_t value) {
+            byte mask = 0xFF;
+
+            // Letters only differ from their other case by bit 5
+            if (options.ignore_case && (((value | 0x20) >= 'a') && ((value | 0x20) <= 'z')))
+            {
+                value &= 0xDF;
+                mask = 0xDF;
+            }
+
+            bytes.push_back(static_cast<byte>(value));
+            masks.push_back(mask);
+
+            if (utf16)
+            {
+                bytes.push_back(static_cast<byte>(value >> 8));
+                masks.push_back(0xFF);
+            }
+        };
+
+        for (std::size_t i = 0; i < length;)
+        {
+            std::uint32_t value = data[i];
+            std::size_t size = 1;
+
+            if (utf16)
+            {
+                // Bytes which are not valid UTF-8 are taken as Latin-1
+                if (const std::size_t decoded = internal::utf8_decode(&data[i], length - i, value))
+                    size = decoded;
+                else
+                    value = data[i];
+            }
+
+            if (value >= 0x10000)
+            {
+                add(0xD800 + ((value - 0x10000) >> 10));
+                add(0xDC00 + ((value - 0x10000) & 0x3FF));
+            }
+            else
+            {
+                add(value);
+            }
+
+            i += size;
+        }
+
+        return pattern(bytes.data(), masks.data(), bytes.size());
+    }
+
+    inline std::vector<pointer> find_text(region range, const char* text, const text_options& options)
+    {
+        return auto_scanner(text_pattern(text, options)).scan_all(range);
+    }
+} // namespace mem
+
+#endif // MEM_STRING_SCANNER_BRICK_H
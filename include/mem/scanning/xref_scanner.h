@@ -0,0 +1,276 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_XREF_SCANNER_BRICK_H
+#define MEM_XREF_SCANNER_BRICK_H
+
+#include <mem/memory/module.h>
+#include <mem/memory/region_set.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(MEM_SIMD_AVX2)
+#    include <immintrin.h>
+#elif defined(MEM_SIMD_SSE2)
+#    include <emmintrin.h>
+#endif
+
+namespace mem
+{
+    enum class xref_kind
+    {
+        relative, // A 32-bit displacement from the end of itself, as used by call, jmp and RIP-relative operands
+        absolute, // A pointer sized, pointer aligned address
+    };
+
+    struct xref
+    {
+        pointer location {nullptr};
+        pointer target {nullptr};
+        xref_kind kind {xref_kind::relative};
+    };
+
+    // Finds references to a set of addresses in code and data
+    class xref_scanner
+    {
+    private:
+        region_set targets_ {};
+
+        // Bounds of targets_, used as a cheap filter before the set lookup
+        std::uintptr_t lowest_ {0};
+        std::uintptr_t extent_ {0};
+
+        bool is_target(std::uintptr_t address) const noexcept;
+
+    public:
+        xref_scanner() = default;
+
+        explicit xref_scanner(pointer target);
+        explicit xref_scanner(region_set targets);
+
+        const region_set& targets() const noexcept;
+
+        // Checks the 32-bit displacement at every byte offset of code, assuming it ends its instruction.
+        // Calls func(xref) for each hit, stopping when it returns true. Returns whether func stopped the scan.
+        template <typename Func>
+        bool scan_code(region code, Func func) const;
+
+        // Checks every aligned pointer in data
+        template <typename Func>
+        bool scan_data(region data, Func func) const;
+
+        // Scans the executable segments of image as code and the other readable ones as data, in a single pass
+        template <typename Func>
+        void scan(module image, Func func) const;
+
+        std::vector<xref> scan_all(module image) const;
+    };
+
+    inline xref_scanner::xref_scanner(pointer target)
+        : xref_scanner(region_set(region(target, 1)))
+    {}
+
+    inline xref_scanner::xref_scanner(region_set targets)
+        : targets_(std::move(targets))
+    {
+        if (targets_.empty())
+            return;
+
+        const region& last = targets_[targets_.size() - 1];
+
+        lowest_ = targets_[0].start.as<std::uintptr_t>();
+        extent_ = last.start.as<std::uintptr_t>() + last.size - lowest_;
+    }
+
+    MEM_STRONG_INLINE bool xref_scanner::is_target(std::uintptr_t address) const noexcept
+    {
+        return (address - lowest_ < extent_) && targets_.contains(address);
+    }
+
+    MEM_STRONG_INLINE const region_set& xref_scanner::targets() const noexcept
+    {
+        return targets_;
+    }
+
+    template <typename Func>
+    inline bool xref_scanner::scan_code(region code, Func func) const
+    {
+        if (!extent_ || code.size < sizeof(std::int32_t))
+            return false;
+
+        const byte* const data = code.start.as<const byte*>();
+        const std::uintptr_t base = code.start.as<std::uintptr_t>();
+        const std::size_t count = code.size - sizeof(std::int32_t) + 1;
+
+        const auto check = [&](std::size_t i) {
+            std::int32_t disp;
+            std::memcpy(&disp, data + i, sizeof(disp));
+
+            const std::uintptr_t target =
+                base + i + sizeof(disp) + static_cast<std::uintptr_t>(static_cast<std::intptr_t>(disp));
+
+            return is_target(target) && func(xref {base + i, target, xref_kind::relative});
+        };
+
+        std::size_t i = 0;
+
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+        // Per offset i, test (disp + i + base + 4 - lowest) < extent in wrapping 32-bit arithmetic.
+        // This never misses a hit, and the few false positives are rejected by the exact check.
+        if (extent_ <= 0x7FFFFFFF)
+        {
+#    if defined(MEM_SIMD_AVX2)
+            using vector = __m256i;
+
+            const auto load = [](const byte* ptr) { return _mm256_loadu_si256(reinterpret_cast<const vector*>(ptr)); };
+            const auto fill = [](std::uint32_t value) { return _mm256_set1_epi32(static_cast<int>(value)); };
+            const auto add = [](vector lhs, vector rhs) { return _mm256_add_epi32(lhs, rhs); };
+            const auto either = [](vector lhs, vector rhs) { return _mm256_or_si256(lhs, rhs); };
+            const auto below = [](vector lhs, vector rhs) { return _mm256_cmpgt_epi32(rhs, lhs); };
+            const auto mask = [](vector value) { return _mm256_movemask_epi8(value); };
+
+            const vector steps = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+#    else
+            using vector = __m128i;
+
+            const auto load = [](const byte* ptr) { return _mm_loadu_si128(reinterpret_cast<const vector*>(ptr)); };
+            const auto fill = [](std::uint32_t value) { return _mm_set1_epi32(static_cast<int>(value)); };
+            const auto add = [](vector lhs, vector rhs) { return _mm_add_epi32(lhs, rhs); };
+            const auto either = [](vector lhs, vector rhs) { return _mm_or_si128(lhs, rhs); };
+            const auto below = [](vector lhs, vector rhs) { return _mm_cmpgt_epi32(rhs, lhs); };
+            const auto mask = [](vector value) { return _mm_movemask_epi8(value); };
+
+            const vector steps = _mm_setr_epi32(0, 4, 8, 12);
+#    endif
+
+            // Each load holds the displacements at offsets j, j + 4, j + 8..., so four loads cover a block
+            constexpr std::size_t block = sizeof(vector);
+
+            // Biasing by the sign bit turns the signed compare into an unsigned one
+            const vector limit = fill(static_cast<std::uint32_t>(extent_) ^ 0x80000000);
+
+            vector offset =
+                add(steps, fill(static_cast<std::uint32_t>(base + sizeof(std::int32_t) - lowest_) ^ 0x80000000));
+
+            const vector next = fill(static_cast<std::uint32_t>(block));
+            const vector one = fill(1);
+            const vector two = fill(2);
+            const vector three = fill(3);
+
+            for (; i + block + sizeof(std::int32_t) <= code.size; i += block)
+            {
+                const vector hit0 = below(add(load(data + i), offset), limit);
+                const vector hit1 = below(add(load(data + i + 1), add(offset, one)), limit);
+                const vector hit2 = below(add(load(data + i + 2), add(offset, two)), limit);
+                const vector hit3 = below(add(load(data + i + 3), add(offset, three)), limit);
+
+                offset = add(offset, next);
+
+                if (MEM_LIKELY(!mask(either(either(hit0, hit1), either(hit2, hit3)))))
+                    continue;
+
+                for (std::size_t j = i; j < i + block; ++j)
+                {
+                    if (check(j))
+                        return true;
+                }
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            if (check(i))
+                return true;
+        }
+
+        return false;
+    }
+
+    template <typename Func>
+    inline bool xref_scanner::scan_data(region data, Func func) const
+    {
+        if (!extent_)
+            return false;
+
+        const pointer start = data.start.align_up(sizeof(void*));
+        const pointer end = data.start.add(data.size).align_down(sizeof(void*));
+
+        if (!(start < end))
+            return false;
+
+        const std::uintptr_t* const words = start.as<const std::uintptr_t*>();
+        const std::size_t count = static_cast<std::size_t>(end - start) / sizeof(std::uintptr_t);
+
+        std::size_t i = 0;
+
+        // Branch free bounds filter, which the compiler can vectorize
+        for (; i + 4 <= count; i += 4)
+        {
+            const bool any = ((words[i] - lowest_) < extent_) | ((words[i + 1] - lowest_) < extent_) |
+                ((words[i + 2] - lowest_) < extent_) | ((words[i + 3] - lowest_) < extent_);
+
+            if (MEM_LIKELY(!any))
+                continue;
+
+            for (std::size_t j = i; j < i + 4; ++j)
+            {
+                if (is_target(words[j]) && func(xref {&words[j], words[j], xref_kind::absolute}))
+                    return true;
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            if (is_target(words[i]) && func(xref {&words[i], words[i], xref_kind::absolute}))
+                return true;
+        }
+
+        return false;
+    }
+
+    template <typename Func>
+    inline void xref_scanner::scan(module image, Func func) const
+    {
+        const auto forward = [&func](const xref& result) { return func(result); };
+
+        image.enum_segments([&](region range, prot_flags prot) {
+            if (!(prot & prot_flags::R))
+                return false;
+
+            return (prot & prot_flags::X) ? scan_code(range, forward) : scan_data(range, forward);
+        });
+    }
+
+    inline std::vector<xref> xref_scanner::scan_all(module image) const
+    {
+        std::vector<xref> results;
+
+        scan(image, [&results](const xref& result) {
+            results.push_back(result);
+            return false;
+        });
+
+        return results;
+    }
+} // namespace mem
+
+#endif // MEM_XREF_SCANNER_BRICK_H
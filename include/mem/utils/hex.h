@@ -0,0 +1,511 @@
+/*
+    Copyright 2026 DeHby
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge, publish, distribute,
+    sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MEM_HEX_BRICK_H
+#define MEM_HEX_BRICK_H
+
+#include <mem/access/data_accessor.h>
+#include <mem/containers/char_queue.h>
+#include <mem/memory/mem.h>
+#include <mem/memory/region.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#if defined(MEM_SIMD_AVX2)
+#    include <immintrin.h>
+#elif defined(MEM_SIMD_SSE2)
+#    include <emmintrin.h>
+#endif
+
+namespace mem
+{
+    // Characters written by hex_encode
+    constexpr std::size_t hex_encoded_size(std::size_t size, bool padded) noexcept;
+
+    // Writes hex_encoded_size(size, padded) characters to output, without a null terminator.
+    // Padded output separates each byte with a space.
+    std::size_t hex_encode(
+        const void* data, std::size_t size, char* output, bool upper_case = true, bool padded = false) noexcept;
+
+    // Writes range to output a chunk at a time
+    void hex_encode(std::ostream& output, region range, bool upper_case = true, bool padded = true);
+
+    // Decodes pairs of hex digits, skipping whitespace between pairs. Returns the number of bytes written to output,
+    // which needs room for length / 2 bytes, or SIZE_MAX if input holds anything else.
+    std::size_t hex_decode(const char* input, std::size_t length, void* output) noexcept;
+
+    struct hexdump_options
+    {
+        // Bytes per line
+        std::size_t width {16};
+
+        bool upper_case {true};
+
+        // Show offsets from the start of the range instead of addresses
+        bool offsets {false};
+
+        // Show the printable bytes of each line after the hex
+        bool ascii {true};
+    };
+
+    // Formats range as lines of "address  hex bytes  |ascii|", using a fixed size buffer
+    void hexdump(std::ostream& output, region range, const hexdump_options& options = {});
+
+    // Reads range through accessor a chunk at a time. Bytes which cannot be read are shown as ??.
+    void hexdump(
+        std::ostream& output, const data_accessor& accessor, region range, const hexdump_options& options = {});
+
+    namespace internal
+    {
+        MEM_STRONG_INLINE const char* hex_digits(bool upper_case) noexcept
+        {
+            return upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+        }
+
+        // Encodes hex_block_size bytes to hex_block_size * 2 characters
+#if defined(MEM_SIMD_AVX2)
+        constexpr std::size_t hex_block_size = 32;
+
+        MEM_STRONG_INLINE void hex_encode_block(const byte* data, char* output, bool upper_case) noexcept
+        {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+            // Digits above 9 skip ahead to the letters
+            const __m256i letters = _mm256_set1_epi8(static_cast<char>((upper_case ? 'A' : 'a') - '0' - 10));
+
+            const auto to_chars = [&](__m256i digits) {
+                return _mm256_add_epi8(_mm256_add_epi8(digits, _mm256_set1_epi8('0')),
+                    _mm256_and_si256(_mm256_cmpgt_epi8(digits, _mm256_set1_epi8(9)), letters));
+            };
+
+            const __m256i high = to_chars(_mm256_and_si256(_mm256_srli_epi16(value, 4), nibble));
+            const __m256i low = to_chars(_mm256_and_si256(value, nibble));
+
+            // Unpacking interleaves within each 128-bit lane, so swap the middle halves back into order
+            const __m256i first = _mm256_unpacklo_epi8(high, low);
+            const __m256i second = _mm256_unpackhi_epi8(high, low);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(output + 32), _mm256_permute2x128_si256(first, second, 0x31));
+        }
+#elif defined(MEM_SIMD_SSE2)
+        constexpr std::size_t hex_block_size = 16;
+
+        MEM_STRONG_INLINE void hex_encode_block(const byte* data, char* output, bool upper_case) noexcept
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+
+            // Digits above 9 skip ahead to the letters
+            const __m128i letters = _mm_set1_epi8(static_cast<char>((upper_case ? 'A' : 'a') - '0' - 10));
+
+            const auto to_chars = [&](__m128i digits) {
+                return _mm_add_epi8(_mm_add_epi8(digits, _mm_set1_epi8('0')),
+                    _mm_and_si128(_mm_cmpgt_epi8(digits, _mm_set1_epi8(9)), letters));
+            };
+
+            const __m128i high = to_chars(_mm_and_si128(_mm_srli_epi16(value, 4), nibble));
+            const __m128i low = to_chars(_mm_and_si128(value, nibble));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(high, low));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(high, low));
+        }
+#endif
+
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+        // Decodes hex_block_size * 2 digits, writing nothing unless they are all valid
+        MEM_STRONG_INLINE bool hex_decode_block(const char* input, byte* output) noexcept
+        {
+#    if defined(MEM_SIMD_AVX2)
+            using vector = __m256i;
+
+            const auto load = [](const char* ptr) { return _mm256_loadu_si256(reinterpret_cast<const vector*>(ptr)); };
+            const auto fill = [](char value) { return _mm256_set1_epi8(value); };
+            const auto either = [](vector lhs, vector rhs) { return _mm256_or_si256(lhs, rhs); };
+            const auto select = [](vector mask, vector lhs, vector rhs) {
+                return _mm256_or_si256(_mm256_and_si256(mask, lhs), _mm256_andnot_si256(mask, rhs));
+            };
+            const auto add = [](vector lhs, vector rhs) { return _mm256_add_epi8(lhs, rhs); };
+            const auto sub = [](vector lhs, vector rhs) { return _mm256_sub_epi8(lhs, rhs); };
+            const auto at_most = [](vector value, vector limit) {
+                return _mm256_cmpeq_epi8(_mm256_subs_epu8(value, limit), _mm256_setzero_si256());
+            };
+            const auto mask = [](vector value) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(value)); };
+
+            // Each 16-bit lane holds a high then a low digit
+            const auto combine = [](vector value) {
+                return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(value, _mm256_set1_epi16(0xFF)), 4),
+                    _mm256_srli_epi16(value, 8));
+            };
+
+            // Packing works within each 128-bit lane, so restore the order of the quarters
+            const auto store = [](byte* ptr, vector lhs, vector rhs) {
+                _mm256_storeu_si256(
+                    reinterpret_cast<vector*>(ptr), _mm256_permute4x64_epi64(_mm256_packus_epi16(lhs, rhs), 0xD8));
+            };
+#    else
+            using vector = __m128i;
+
+            const auto load = [](const char* ptr) { return _mm_loadu_si128(reinterpret_cast<const vector*>(ptr)); };
+            const auto fill = [](char value) { return _mm_set1_epi8(value); };
+            const auto either = [](vector lhs, vector rhs) { return _mm_or_si128(lhs, rhs); };
+            const auto select = [](vector mask, vector lhs, vector rhs) {
+                return _mm_or_si128(_mm_and_si128(mask, lhs), _mm_andnot_si128(mask, rhs));
+            };
+            const auto add = [](vector lhs, vector rhs) { return _mm_add_epi8(lhs, rhs); };
+            const auto sub = [](vector lhs, vector rhs) { return _mm_sub_epi8(lhs, rhs); };
+            const auto at_most = [](vector value, vector limit) {
+                return _mm_cmpeq_epi8(_mm_subs_epu8(value, limit), _mm_setzero_si128());
+            };
+            const auto mask = [](vector value) { return static_cast<std::uint32_t>(_mm_movemask_epi8(value)); };
+
+            // Each 16-bit lane holds a high then a low digit
+            const auto combine = [](vector value) {
+                return _mm_or_si128(
+                    _mm_slli_epi16(_mm_and_si128(value, _mm_set1_epi16(0xFF)), 4), _mm_srli_epi16(value, 8));
+            };
+
+            const auto store = [](byte* ptr, vector lhs, vector rhs) {
+                _mm_storeu_si128(reinterpret_cast<vector*>(ptr), _mm_packus_epi16(lhs, rhs));
+            };
+#    endif
+
+            constexpr std::uint32_t all = (sizeof(vector) == 32) ? 0xFFFFFFFF : 0xFFFF;
+
+            std::uint32_t valid = all;
+
+            const auto digits = [&](vector value) {
+                // Unsigned range checks, with wrapping subtraction
+                const vector decimal = sub(value, fill('0'));
+                const vector letter = sub(either(value, fill(0x20)), fill('a'));
+
+                const vector is_decimal = at_most(decimal, fill(9));
+
+                valid &= mask(either(is_decimal, at_most(letter, fill(5))));
+
+                return select(is_decimal, decimal, add(letter, fill(10)));
+            };
+
+            const vector first = digits(load(input));
+            const vector second = digits(load(input + sizeof(vector)));
+
+            if (valid != all)
+                return false;
+
+            store(output, combine(first), combine(second));
+
+            return true;
+        }
+#endif
+    } // namespace internal
+
+    constexpr std::size_t hex_encoded_size(std::size_t size, bool padded) noexcept
+    {
+        return padded ? (size ? (size * 3 - 1) : 0) : (size * 2);
+    }
+
+    inline std::size_t hex_encode(
+        const void* data, std::size_t size, char* output, bool upper_case, bool padded) noexcept
+    {
+        const byte* const input = static_cast<const byte*>(data);
+        const char* const digits = internal::hex_digits(upper_case);
+
+        std::size_t i = 0;
+
+        if (padded)
+        {
+            char* current = output;
+
+            for (; i < size; ++i)
+            {
+                if (i)
+                    *current++ = ' ';
+
+                current[0] = digits[input[i] >> 4];
+                current[1] = digits[input[i] & 0xF];
+                current += 2;
+            }
+
+            return static_cast<std::size_t>(current - output);
+        }
+
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+        for (; i + internal::hex_block_size <= size; i += internal::hex_block_size)
+            internal::hex_encode_block(input + i, output + i * 2, upper_case);
+#endif
+
+        for (; i < size; ++i)
+        {
+            output[i * 2] = digits[input[i] >> 4];
+            output[i * 2 + 1] = digits[input[i] & 0xF];
+        }
+
+        return size * 2;
+    }
+
+    inline void hex_encode(std::ostream& output, region range, bool upper_case, bool padded)
+    {
+        constexpr std::size_t chunk_size = 0x1000;
+
+        char buffer[hex_encoded_size(chunk_size, true) + 1];
+
+        const byte* const data = range.start.as<const byte*>();
+
+        for (std::size_t i = 0; i < range.size; i += chunk_size)
+        {
+            const std::size_t size = (std::min)(chunk_size, range.size - i);
+
+            std::size_t length = 0;
+
+            // Keep the separator between chunks
+            if (padded && i)
+                buffer[length++] = ' ';
+
+            length += hex_encode(data + i, size, buffer + length, upper_case, padded);
+
+            output.write(buffer, static_cast<std::streamsize>(length));
+        }
+    }
+
+    inline std::size_t hex_decode(const char* input, std::size_t length, void* output) noexcept
+    {
+        byte* const result = static_cast<byte*>(output);
+
+        std::size_t i = 0;
+        std::size_t count = 0;
+
+        while (true)
+        {
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+            constexpr std::size_t block = internal::hex_block_size;
+
+            while ((i + block * 2 <= length) && internal::hex_decode_block(input + i, result + count))
+            {
+                i += block * 2;
+                count += block;
+            }
+#endif
+
+            while ((i < length) &&
+                ((input[i] == ' ') || (input[i] == '\t') || (input[i] == '\n') || (input[i] == '\r')))
+                ++i;
+
+            if (i == length)
+                break;
+
+            const int high = xctoi(static_cast<byte>(input[i]));
+            const int low = (i + 1 < length) ? xctoi(static_cast<byte>(input[i + 1])) : -1;
+
+            if ((high == -1) || (low == -1))
+                return SIZE_MAX;
+
+            result[count++] = static_cast<byte>((high << 4) | low);
+            i += 2;
+        }
+
+        return count;
+    }
+
+    namespace internal
+    {
+        // Formats whole lines into a fixed buffer, writing it out whenever it fills
+        class hexdump_writer
+        {
+        private:
+            std::ostream& output_;
+            hexdump_options options_;
+
+            std::uintptr_t base_ {0};
+            std::size_t address_width_ {0};
+            std::size_t hex_width_ {0};
+            std::size_t line_size_ {0};
+
+            std::vector<char> buffer_ {};
+            std::size_t used_ {0};
+
+        public:
+            hexdump_writer(std::ostream& output, const hexdump_options& options, std::uintptr_t base);
+            ~hexdump_writer();
+
+            hexdump_writer(const hexdump_writer&) = delete;
+            hexdump_writer& operator=(const hexdump_writer&) = delete;
+
+            std::size_t width() const noexcept;
+
+            // Writes the line for [address, address + size), where data is nullptr if it could not be read
+            void line(std::uintptr_t address, const byte* data, std::size_t size);
+
+            void flush();
+        };
+
+        inline hexdump_writer::hexdump_writer(std::ostream& output, const hexdump_options& options, std::uintptr_t base)
+            : output_(output)
+            , options_(options)
+            , base_(base)
+        {
+            if (!options_.width)
+                options_.width = 16;
+
+            address_width_ = options_.offsets ? 8 : (sizeof(std::uintptr_t) * 2);
+
+            // Each group of 8 bytes starts with an extra space
+            hex_width_ = options_.width * 3 + (options_.width + 7) / 8;
+
+            line_size_ = address_width_ + 1 + hex_width_ + (options_.ascii ? (options_.width + 3) : 0) + 1;
+
+            buffer_.resize((std::max)(std::size_t(0x2000), line_size_));
+        }
+
+        inline hexdump_writer::~hexdump_writer()
+        {
+            flush();
+        }
+
+        MEM_STRONG_INLINE std::size_t hexdump_writer::width() const noexcept
+        {
+            return options_.width;
+        }
+
+        inline void hexdump_writer::line(std::uintptr_t address, const byte* data, std::size_t size)
+        {
+            if (used_ + line_size_ > buffer_.size())
+                flush();
+
+            const char* const digits = hex_digits(options_.upper_case);
+
+            char* const start = &buffer_[used_];
+            char* current = start;
+
+            std::uintptr_t shown = options_.offsets ? (address - base_) : address;
+
+            for (std::size_t i = address_width_; i--; shown >>= 4)
+                current[i] = digits[shown & 0xF];
+
+            current += address_width_;
+            *current++ = ' ';
+
+            for (std::size_t i = 0; i < options_.width; ++i)
+            {
+                if (!(i % 8))
+                    *current++ = ' ';
+
+                if (i >= size)
+                {
+                    current[0] = ' ';
+                    current[1] = ' ';
+                }
+                else if (data)
+                {
+                    current[0] = digits[data[i] >> 4];
+                    current[1] = digits[data[i] & 0xF];
+                }
+                else
+                {
+                    current[0] = '?';
+                    current[1] = '?';
+                }
+
+                current[2] = ' ';
+                current += 3;
+            }
+
+            if (options_.ascii)
+            {
+                *current++ = ' ';
+                *current++ = '|';
+
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    const byte value = data ? data[i] : '?';
+
+                    *current++ = ((value >= 0x20) && (value < 0x7F)) ? static_cast<char>(value) : '.';
+                }
+
+                *current++ = '|';
+            }
+            else
+            {
+                while (current[-1] == ' ')
+                    --current;
+            }
+
+            *current++ = '\n';
+
+            used_ += static_cast<std::size_t>(current - start);
+        }
+
+        inline void hexdump_writer::flush()
+        {
+            if (used_)
+                output_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+
+            used_ = 0;
+        }
+    } // namespace internal
+
+    inline void hexdump(std::ostream& output, region range, const hexdump_options& options)
+    {
+        const std::uintptr_t start = range.start.as<std::uintptr_t>();
+
+        internal::hexdump_writer writer(output, options, start);
+
+        const std::size_t width = writer.width();
+
+        for (std::size_t i = 0; i < range.size; i += width)
+            writer.line(start + i, range.start.add(i).as<const byte*>(), (std::min)(width, range.size - i));
+    }
+
+    inline void hexdump(
+        std::ostream& output, const data_accessor& accessor, region range, const hexdump_options& options)
+    {
+        const std::uintptr_t start = range.start.as<std::uintptr_t>();
+
+        internal::hexdump_writer writer(output, options, start);
+
+        const std::size_t width = writer.width();
+
+        // A whole number of lines, so only the last chunk has a partial line
+        std::vector<byte> buffer((std::max)(std::size_t(0x10000) / width, std::size_t(1)) * width);
+
+        for (std::size_t i = 0; i < range.size; i += buffer.size())
+        {
+            const std::size_t size = (std::min)(buffer.size(), range.size - i);
+
+            // Retry a line at a time to narrow down which bytes could not be read
+            const bool whole = accessor.read(reinterpret_cast<void*>(start + i), buffer.data(), size);
+
+            for (std::size_t j = 0; j < size; j += width)
+            {
+                const std::size_t count = (std::min)(width, size - j);
+
+                const bool readable =
+                    whole || accessor.read(reinterpret_cast<void*>(start + i + j), buffer.data() + j, count);
+
+                writer.line(start + i + j, readable ? buffer.data() + j : nullptr, count);
+            }
+        }
+    }
+} // namespace mem
+
+#endif // MEM_HEX_BRICK_H
@@ -20,12 +20,23 @@
 #ifndef MEM_UTILS_BRICK_H
 #define MEM_UTILS_BRICK_H
 
+#include <mem/containers/char_queue.h>
 #include <mem/memory/mem.h>
+#include <mem/memory/region.h>
+#include <mem/utils/hex.h>
 
 #include <string>
 #include <vector>
 
-#include "char_queue.h"
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+#    include <mem/core/arch.h>
+#endif
+
+#if defined(MEM_SIMD_AVX2)
+#    include <immintrin.h>
+#elif defined(MEM_SIMD_SSE2)
+#    include <emmintrin.h>
+#endif
 
 namespace mem
 {
@@ -37,17 +48,60 @@ namespace mem
 
     std::vector<byte> unescape(const char* string, std::size_t length, bool strict = false);
 
-    MEM_STRONG_INLINE bool is_ascii(region range) noexcept
+    namespace internal
     {
-        for (std::size_t i = 0; i < range.size; ++i)
+        // Length of the leading run of ASCII bytes in data
+        inline std::size_t ascii_prefix(const byte* data, std::size_t size) noexcept
         {
-            if (range.start.at<const byte>(i) >= 0x80)
+            std::size_t i = 0;
+
+#if defined(MEM_SIMD_AVX2) || defined(MEM_SIMD_SSE2)
+#    if defined(MEM_SIMD_AVX2)
+            using vector = __m256i;
+
+            const auto load = [](const byte* ptr) { return _mm256_loadu_si256(reinterpret_cast<const vector*>(ptr)); };
+            const auto either = [](vector lhs, vector rhs) { return _mm256_or_si256(lhs, rhs); };
+            const auto mask = [](vector value) { return _mm256_movemask_epi8(value); };
+#    else
+            using vector = __m128i;
+
+            const auto load = [](const byte* ptr) { return _mm_loadu_si128(reinterpret_cast<const vector*>(ptr)); };
+            const auto either = [](vector lhs, vector rhs) { return _mm_or_si128(lhs, rhs); };
+            const auto mask = [](vector value) { return _mm_movemask_epi8(value); };
+#    endif
+
+            constexpr std::size_t block = sizeof(vector);
+
+            // Top bits of four vectors at once, then find the exact byte in the block which had one
+            for (; i + block * 4 <= size; i += block * 4)
             {
-                return false;
+                const vector merged = either(either(load(data + i), load(data + i + block)),
+                    either(load(data + i + block * 2), load(data + i + block * 3)));
+
+                if (MEM_UNLIKELY(mask(merged)))
+                    break;
+            }
+
+            for (; i + block <= size; i += block)
+            {
+                if (const int bits = mask(load(data + i)))
+                    return i + bsf(static_cast<unsigned int>(bits));
+            }
+#endif
+
+            for (; i < size; ++i)
+            {
+                if (data[i] >= 0x80)
+                    break;
             }
+
+            return i;
         }
+    } // namespace internal
 
-        return true;
+    MEM_STRONG_INLINE bool is_ascii(region range) noexcept
+    {
+        return internal::ascii_prefix(range.start.as<const byte*>(), range.size) == range.size;
     }
 
     inline bool is_utf8(region range) noexcept
@@ -74,8 +128,18 @@ namespace mem
         };
         // clang-format on
 
+        const byte* const data = range.start.as<const byte*>();
+
         for (std::size_t i = 0; i < range.size;)
         {
+            // Skip ASCII a block at a time, and only decode multi-byte sequences
+            i += internal::ascii_prefix(data + i, range.size - i);
+
+            if (i == range.size)
+            {
+                break;
+            }
+
             const std::size_t length = utf8_length_table[range.start.at<const byte>(i)];
 
             if (length == 0)
@@ -109,23 +173,11 @@ namespace mem
 
     inline std::string as_hex(region range, bool upper_case, bool padded)
     {
-        const char* const char_hex_table = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
-
-        std::string result;
+        std::string result(hex_encoded_size(range.size, padded), '\0');
 
-        result.reserve(range.size * (padded ? 3 : 2));
-
-        for (std::size_t i = 0; i < range.size; ++i)
+        if (!result.empty())
         {
-            if (i && padded)
-            {
-                result.push_back(' ');
-            }
-
-            const byte value = range.start.at<const byte>(i);
-
-            result.push_back(char_hex_table[(value >> 4) & 0xF]);
-            result.push_back(char_hex_table[(value >> 0) & 0xF]);
+            hex_encode(range.start.as<const void*>(), range.size, &result[0], upper_case, padded);
         }
 
         return result;
@@ -32,8 +32,24 @@
 #include <mem/pattern.h>
 #include <mem/pattern_cache.h>
 
+#include <mem/alloc/arena.h>
+#include <mem/alloc/buffer_pool.h>
+#include <mem/alloc/code_allocator.h>
+#include <mem/access/checked_local_accessor.h>
+
 #include <mem/simd_scanner.h>
 #include <mem/boyer_moore_scanner.h>
+#include <mem/scanning/auto_scanner.h>
+#include <mem/scanning/memory_scanner.h>
+#include <mem/scanning/xref_scanner.h>
+#include <mem/scanning/pointer_map.h>
+#include <mem/scanning/string_scanner.h>
+#include <mem/scanning/signature_file.h>
+#include <mem/scanning/signature_pack.h>
+#include <mem/memory/region_set.h>
+#include <mem/memory/pe_image.h>
+#include <mem/memory/msvc_rtti.h>
+#include <mem/utils/hex.h>
 
 #include <mem/prot_flags.h>
 #include <mem/protect.h>
@@ -41,6 +57,7 @@
 #include <mem/module.h>
 #include <mem/aligned_alloc.h>
 #include <mem/execution_handler.h>
+#include <mem/exception/fault_guard.h>
 
 #include <mem/macros.h>
 
@@ -48,6 +65,19 @@
 # include <mem/rtti.h>
 #endif
 
+#if defined(__unix__)
+# include <mem/memory/module_list.h>
+# include <mem/memory/rtti.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 
@@ -190,71 +220,2168 @@ TEST_CASE("mem::pattern scan")
     mem::protect_free(raw_data, raw_size);
 }
 
-TEST_CASE("mem::region contains")
+std::vector<size_t> naive_scan_all(const mem::pattern& pattern, const std::vector<uint8_t>& data)
 {
-    REQUIRE(mem::region(0x1234, 0x10).contains(mem::region(0x1234, 0x10)));
-    REQUIRE(mem::region(0x1234, 0x10).contains(mem::region(0x1235, 0x09)));
-    REQUIRE(!mem::region(0x1234, 0x10).contains(mem::region(0x1235, 0x10)));
+    std::vector<size_t> results;
 
-    REQUIRE(mem::region(0x1234, 0x10).contains(0x1234, 0x10));
-    REQUIRE(mem::region(0x1234, 0x10).contains(0x1235, 0x09));
-    REQUIRE(!mem::region(0x1234, 0x10).contains(0x1235, 0x10));
+    if (!pattern.trimmed_size() || pattern.size() > data.size())
+        return results;
 
-    REQUIRE(mem::region(0x1234, 0x10).contains(0x1234));
-    REQUIRE(mem::region(0x1234, 0x10).contains(0x1234 + 0x9));
-    REQUIRE(mem::region(0x1234, 1).contains(0x1234));
-    REQUIRE(!mem::region(0x1234, 0x10).contains(0x1233));
-    REQUIRE(!mem::region(0x1234, 0x10).contains(0x1234 + 0x10));
-    REQUIRE(!mem::region(0x1234, 0).contains(0x1234));
+    for (size_t i = 0; i + pattern.size() <= data.size(); ++i)
+    {
+        size_t j = 0;
 
-    REQUIRE(mem::region(0x1234, 4).contains<int>(0x1234));
-    REQUIRE(mem::region(0x1234, 4).contains<int>(0x1234));
-    REQUIRE(!mem::region(0x1234, 3).contains<int>(0x1234));
-    REQUIRE(!mem::region(0x1235, 3).contains<int>(0x1234));
+        while ((j < pattern.trimmed_size()) && ((data[i + j] & pattern.masks()[j]) == pattern.bytes()[j]))
+            ++j;
+
+        if (j == pattern.trimmed_size())
+            results.push_back(i);
+    }
+
+    return results;
 }
 
-void check_pointer_aligment(mem::pointer address, size_t alignment, mem::pointer aligned_down, mem::pointer aligned_up)
+template <typename Scanner>
+void check_scanner_results(const mem::pattern& pattern, size_t seed, size_t planted)
 {
-    REQUIRE(address.align_down(alignment) == aligned_down);
-    REQUIRE(address.align_up(alignment) == aligned_up);
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(seed));
+    std::vector<uint8_t> data(64 * 1024);
+
+    // Skewed towards a few byte values so that partial matches are common
+    for (auto& value : data)
+        value = (rng() % 4) ? static_cast<uint8_t>(rng() % 8) : static_cast<uint8_t>(rng());
+
+    for (size_t i = 0; i < planted; ++i)
+    {
+        size_t offset = rng() % (data.size() - pattern.size());
+
+        for (size_t j = 0; j < pattern.size(); ++j)
+            data[offset + j] = static_cast<uint8_t>((data[offset + j] & ~pattern.masks()[j]) | pattern.bytes()[j]);
+    }
+
+    Scanner scanner(pattern);
+
+    std::vector<size_t> results;
+
+    for (mem::pointer result : scanner.scan_all(mem::region(data.data(), data.size())))
+        results.push_back(static_cast<size_t>(result - data.data()));
+
+    REQUIRE(results == naive_scan_all(pattern, data));
 }
 
-TEST_CASE("mem::pointer align")
+TEST_CASE("mem::signature_file")
 {
-    CHECK_NOTHROW(check_pointer_aligment(13, 1, 13, 13));
-    CHECK_NOTHROW(check_pointer_aligment(13, 2, 12, 14));
-    CHECK_NOTHROW(check_pointer_aligment(13, 5, 10, 15));
-    CHECK_NOTHROW(check_pointer_aligment(16, 5, 15, 20));
-    CHECK_NOTHROW(check_pointer_aligment(14, 5, 10, 15));
-    CHECK_NOTHROW(check_pointer_aligment(15, 15, 15, 15));
+    const char text[] =
+        "# Comment\n"
+        "first = 48 8B 05 ? ? ? ? E8\r\n"
+        "\n"
+        "  third=C3   \n"
+        "4? ?F ?? 90\n"
+        "; Another comment\n"
+        "bad = 48 8B 0\n"
+        "second = 90 ?? ??\n"
+        "= 90\n";
+
+    const mem::signature_file file = mem::signature_file::parse(text, sizeof(text) - 1);
+
+    CHECK(!file);
+    CHECK(file.error_line() == 7);
+    REQUIRE(file.size() == 4);
+
+    const auto same = [](mem::pattern_view lhs, const mem::pattern& rhs) {
+        return (lhs.size() == rhs.size()) && (lhs.trimmed_size() == rhs.trimmed_size()) &&
+            (lhs.needs_masks() == rhs.needs_masks()) && !std::memcmp(lhs.bytes(), rhs.bytes(), rhs.size()) &&
+            !std::memcmp(lhs.masks(), rhs.masks(), rhs.size());
+    };
+
+    CHECK(std::string(file[0].name) == "first");
+    CHECK(file[0].line == 2);
+    CHECK(same(file[0].pattern, mem::pattern("48 8B 05 ? ? ? ? E8")));
+
+    CHECK(std::string(file[1].name) == "third");
+    CHECK(same(file[1].pattern, mem::pattern("C3")));
+
+    CHECK(std::string(file[2].name).empty());
+    CHECK(file[2].line == 5);
+    CHECK(same(file[2].pattern, mem::pattern("4? ?F ?? 90")));
+
+    CHECK(same(file[3].pattern, mem::pattern("90 ?? ??")));
+    CHECK(file[3].pattern.to_string() == "90 ? ?");
+
+    CHECK(file.find("second") == &file[3]);
+    CHECK(file.find("first") == &file[0]);
+    CHECK(file.find("bad") == nullptr);
+    CHECK(file.find("") == nullptr);
+
+    // Scanners take the views directly
+    const mem::byte data[] {0x00, 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xE8, 0x4A, 0xBF, 0x00, 0x90};
+    const mem::region range(data, sizeof(data));
+
+    CHECK(mem::simd_scanner(file.find("first")->pattern).scan(range) == &data[1]);
+    CHECK(mem::boyer_moore_scanner(file[2].pattern).scan(range) == &data[9]);
+    CHECK(mem::auto_scanner(file[2].pattern).scan_all(range) == std::vector<mem::pointer> {&data[9]});
+    CHECK(file[0].pattern.match(&data[1]));
+
+    CHECK(mem::signature_file::parse("a = 12 34\nb = ?? ?5\n", 20));
+
+    const char* const path = "mem_signature_file_test.txt";
+
+    if (FILE* output = std::fopen(path, "wb"))
+    {
+        std::fwrite(text, 1, sizeof(text) - 1, output);
+        std::fclose(output);
+
+        const mem::signature_file loaded = mem::signature_file::load(path);
+        std::remove(path);
+
+        CHECK(loaded.error_line() == 7);
+        REQUIRE(loaded.size() == 4);
+        CHECK(same(loaded.find("first")->pattern, mem::pattern("48 8B 05 ? ? ? ? E8")));
+    }
+
+    CHECK(!mem::signature_file::load("mem_signature_file_missing.txt"));
+}
+
+TEST_CASE("mem::signature_pack")
+{
+    const char text[] =
+        "short = 48 8B 05 ? ? ? ? E8\n"
+        "long = 00 01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F 10 11 12 13 14 15 16 17 18 19 1A 1B 1C 1D\n"
+        "masked = 55 48 89 E5 ? ? ? ? 41 57 41 56 41 55 41 54 53 48 83 EC ? 48 8B ? ? ? 00 00\n"
+        "90 90 ? C3\n"
+        "tiny = C3\n";
+
+    const mem::signature_file file = mem::signature_file::parse(text, sizeof(text) - 1);
+    REQUIRE(file);
+
+    std::ostringstream output;
+    REQUIRE(mem::signature_pack::compile(file, output));
+
+    const std::string packed = output.str();
+
+    // view needs 4 byte alignment, which a vector of words guarantees
+    std::vector<std::uint32_t> storage((packed.size() + 3) / 4);
+    std::memcpy(storage.data(), packed.data(), packed.size());
+
+    const mem::signature_pack pack = mem::signature_pack::view(storage.data(), packed.size());
+    REQUIRE(pack);
+    REQUIRE(pack.size() == file.size());
+
+    std::vector<mem::byte> data(0x4000);
+    std::uint32_t seed = 0x12345678;
+
+    for (mem::byte& value : data)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = static_cast<mem::byte>(seed >> 16);
+    }
+
+    for (std::size_t i = 0; i < file.size(); ++i)
+    {
+        const mem::pattern_view pattern = file[i].pattern;
+
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            mem::byte* const target = &data[0x1000 * j + 0x123 * i + 7];
+
+            for (std::size_t k = 0; k < pattern.size(); ++k)
+                target[k] = static_cast<mem::byte>((target[k] & ~pattern.masks()[k]) | pattern.bytes()[k]);
+        }
+    }
+
+    const mem::region range(data.data(), data.size());
+
+    for (std::size_t i = 0; i < file.size(); ++i)
+    {
+        CAPTURE(i);
+
+        CHECK(std::string(pack.name(i)) == file[i].name);
+        CHECK(pack[i].line == file[i].line);
+        CHECK(pack.pattern(i).to_string() == file[i].pattern.to_string());
+        CHECK(pack.pattern(i).trimmed_size() == file[i].pattern.trimmed_size());
+        CHECK(pack.pattern(i).needs_masks() == file[i].pattern.needs_masks());
+
+        const mem::boyer_moore_scanner built(file[i].pattern);
+        const mem::boyer_moore_tables expected = built.tables();
+        const mem::boyer_moore_tables loaded = pack.boyer_moore(i).tables();
+
+        CHECK(loaded.skip_pos == expected.skip_pos);
+        CHECK(loaded.max_skip == expected.max_skip);
+        CHECK(loaded.qgram_size == expected.qgram_size);
+        CHECK((loaded.bc_skips != nullptr) == (expected.bc_skips != nullptr));
+        CHECK((loaded.gs_skips != nullptr) == (expected.gs_skips != nullptr));
+        CHECK((loaded.qgram_skips != nullptr) == (expected.qgram_skips != nullptr));
+
+        // The tables are used in place
+        if (loaded.bc_skips)
+            CHECK(reinterpret_cast<const char*>(loaded.bc_skips) > reinterpret_cast<const char*>(storage.data()));
+
+        CHECK(pack.simd(i).skip_pos() == mem::simd_scanner(file[i].pattern).skip_pos());
+
+        const std::vector<mem::pointer> results = mem::simd_scanner(file[i].pattern).scan_all(range);
+
+        CHECK(results.size() >= 3);
+        CHECK(pack.simd(i).scan_all(range) == results);
+        CHECK(pack.boyer_moore(i).scan_all(range) == results);
+        CHECK(pack.scanner(i).scan_all(range) == results);
+    }
+
+    CHECK(pack.find("long") == 1);
+    CHECK(pack.find("tiny") == 4);
+    CHECK(pack.find("missing") == SIZE_MAX);
+    CHECK(pack.find("") == SIZE_MAX);
+
+    // Anything which does not match the layout is rejected
+    std::vector<std::uint32_t> corrupt = storage;
+    reinterpret_cast<std::uint16_t*>(corrupt.data())[2] = mem::signature_pack::version + 1;
+    CHECK(!mem::signature_pack::view(corrupt.data(), packed.size()));
+
+    corrupt = storage;
+    corrupt[0] = 0x4D53504B;
+    CHECK(!mem::signature_pack::view(corrupt.data(), packed.size()));
+
+    CHECK(!mem::signature_pack::view(storage.data(), packed.size() - 4));
+    CHECK(!mem::signature_pack::view(nullptr, 0));
+
+    const char* const signatures_path = "mem_signature_pack_test.txt";
+    const char* const pack_path = "mem_signature_pack_test.bin";
+
+    if (FILE* text_output = std::fopen(signatures_path, "wb"))
+    {
+        std::fwrite(text, 1, sizeof(text) - 1, text_output);
+        std::fclose(text_output);
+
+        CHECK(mem::signature_pack::compile(signatures_path, pack_path));
+
+        {
+            const mem::signature_pack loaded = mem::signature_pack::load(pack_path);
+
+            REQUIRE(loaded);
+            CHECK(loaded.size() == file.size());
+            CHECK(loaded.scanner(loaded.find("masked")).scan_all(range) == pack.scanner(2).scan_all(range));
+        }
+
+        std::remove(signatures_path);
+        std::remove(pack_path);
+    }
+
+    CHECK(!mem::signature_pack::load("mem_signature_pack_missing.bin"));
+}
+
+TEST_CASE("mem::boyer_moore_scanner scan")
+{
+    const char* patterns[] {
+        "01 02 03 ? ? 04 05 06",
+        "E8 ? ? ? ? 01 02 03",
+        "? 01 02 ? 03 04 ? 05 06 07",
+        "01 ?2 03 04 ? 05 ?6 07",
+        "01 02 ? 03 ? 04 05 ? ? 06 07 02",
+        "01 02 03 04 ? ? 05 06 07 01 02 03 04 05 06 07 01 02 03 04 05 06",
+        "01 ? 01 ? 01 ? 01",
+        "00 00 ? ? 00 00 00",
+        "01 02 03 04 05 06 07",
+        "01 02 03 04 05 06 07 ? 01 02 03 04 05 06 07 01 02",
+        "01 02 03 04 05 06 07 01 02 03 04 05 06 07 01 02 03 04 05 06 07 01 02 03 04 05 06",
+    };
+
+    size_t short_runs = 0;
+
+    for (const char* text : patterns)
+    {
+        mem::pattern pattern(text);
+
+        CHECK_NOTHROW(check_scanner_results<mem::boyer_moore_scanner>(pattern, 1, 0));
+        CHECK_NOTHROW(check_scanner_results<mem::boyer_moore_scanner>(pattern, 2, 16));
+        CHECK_NOTHROW(check_scanner_results<mem::boyer_moore_scanner>(pattern, 3, 512));
+
+        size_t longest_run = 0;
+
+        for (size_t i = 0, run = 0; i < pattern.size(); ++i)
+        {
+            run = (pattern.masks()[i] == 0xFF) ? (run + 1) : 0;
+            longest_run = std::max(longest_run, run);
+        }
+
+        // Too short for the bad character table, so these must skip on q-grams rather than fall back
+        if (pattern.needs_masks() && (longest_run >= 3) && (longest_run <= 4))
+        {
+            const mem::boyer_moore_scanner scanner(pattern);
+
+            CHECK(scanner.tables().qgram_size != 0);
+            CHECK(scanner.max_skip() > 1);
+
+            ++short_runs;
+        }
+    }
+
+    CHECK(short_runs >= 4);
+}
+
+TEST_CASE("mem::auto_scanner scan")
+{
+    const char* patterns[] {
+        "9A 01 02 03 04 05 06 07 08 09",
+        "00 48 FF 01 00 48 FF 01 00 48 FF 01",
+        "E8 ? ? ? ? 01 02 03",
+        "? ?1 ? 02",
+        "01 02 03",
+    };
+
+    for (const char* text : patterns)
+    {
+        mem::pattern pattern(text);
+
+        CHECK_NOTHROW(check_scanner_results<mem::auto_scanner>(pattern, 1, 0));
+        CHECK_NOTHROW(check_scanner_results<mem::auto_scanner>(pattern, 2, 16));
+        CHECK_NOTHROW(check_scanner_results<mem::auto_scanner>(pattern, 3, 512));
+    }
+
+    mem::auto_scanner_thresholds thresholds;
+
+    mem::pattern rare_anchor("9A 01 02 03 04 05 06 07 08 09");
+    CHECK(mem::auto_scanner(rare_anchor, thresholds).engine() == mem::scan_engine::simd);
+
+    mem::pattern common_bytes("00 48 FF 01 00 48 FF 01 00 48 FF 01");
+    CHECK(mem::auto_scanner(common_bytes, thresholds).engine() == mem::scan_engine::boyer_moore);
+    CHECK(mem::auto_scanner(common_bytes, thresholds).select(0x100) == mem::scan_engine::simd);
+
+    CHECK(mem::auto_scanner(mem::pattern(""), thresholds).engine() == mem::scan_engine::none);
+    CHECK(std::string(mem::engine_name(mem::scan_engine::boyer_moore)) == "boyer_moore");
+
+    const mem::auto_scanner_thresholds defaults = mem::auto_scanner::thresholds();
+
+    const mem::auto_scanner_thresholds calibrated = mem::auto_scanner::calibrate();
+    CHECK(calibrated.rare_anchor_rank < 0x100);
+    CHECK(mem::auto_scanner::thresholds().rare_anchor_rank == defaults.rare_anchor_rank);
+
+    mem::auto_scanner::set_thresholds(calibrated);
+    CHECK(mem::auto_scanner::thresholds().rare_anchor_rank == calibrated.rare_anchor_rank);
+    CHECK(mem::auto_scanner(rare_anchor).engine() == mem::auto_scanner(rare_anchor, calibrated).engine());
+
+    // Later test cases expect the defaults
+    mem::auto_scanner::set_thresholds(defaults);
+}
+
+TEST_CASE("mem::scanner scan_all overlapping")
+{
+    std::vector<uint8_t> data(16 * 1024);
+
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = (i % 2) ? 0x02 : 0x01;
+
+    data[5000] = 0x03;
+
+    const char* patterns[] {
+        "01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02 01 02",
+        "01 02 01 02 01 02 01 02",
+        "01 ? 01 02",
+        "02 01",
+    };
+
+    for (const char* text : patterns)
+    {
+        mem::pattern pattern(text);
+        const mem::region range(data.data(), data.size());
+
+        const std::vector<size_t> expected = naive_scan_all(pattern, data);
+
+        const auto offsets = [&data](const std::vector<mem::pointer>& results) {
+            std::vector<size_t> result;
+
+            for (mem::pointer p : results)
+                result.push_back(static_cast<size_t>(p - data.data()));
+
+            return result;
+        };
+
+        CHECK(offsets(mem::simd_scanner(pattern).scan_all(range)) == expected);
+        CHECK(offsets(mem::boyer_moore_scanner(pattern).scan_all(range)) == expected);
+        CHECK(offsets(mem::auto_scanner(pattern).scan_all(range)) == expected);
+    }
+}
+
+TEST_CASE("mem::scanner_base sinks")
+{
+    std::vector<uint8_t> data(4096, 0x90);
+
+    for (size_t i = 0; i < data.size(); i += 64)
+        std::memcpy(&data[i + 3], "\x01\x02\x03\x04", 4);
+
+    const mem::region range(data.data(), data.size());
+    const mem::pattern pattern("01 02 ? 04");
+    const mem::simd_scanner scanner(pattern);
+
+    const std::vector<mem::pointer> expected = scanner.scan_all(range);
+    REQUIRE(expected.size() == 64);
+
+    std::vector<mem::pointer> results;
+    scanner.scan_into(range, std::back_inserter(results));
+    CHECK(results == expected);
+
+    CHECK(scanner.scan_count(range) == 64);
+
+    mem::pointer buffer[8];
+    CHECK(scanner.scan_into(range, buffer, 8) == 64);
+    CHECK(std::equal(buffer, buffer + 8, expected.begin()));
+
+    CHECK(scanner.scan_first(range, 5) == std::vector<mem::pointer>(expected.begin(), expected.begin() + 5));
+    CHECK(scanner.scan_first(range, 100) == expected);
+    CHECK(scanner.scan_first(range, 0).empty());
+
+    results.clear();
+
+    for (mem::pointer result : scanner.hits(range))
+        results.push_back(result);
+
+    CHECK(results == expected);
+
+    const mem::pattern missing("05 06 07");
+    const mem::boyer_moore_scanner none(missing);
+    CHECK(none.hits(range).begin() == none.hits(range).end());
+    CHECK(none.scan_count(range) == 0);
+}
+
+TEST_CASE("mem::memory_scanner scan")
+{
+    std::vector<uint8_t> data(64 * 1024);
+    std::mt19937 rng(7);
+
+    for (auto& value : data)
+        value = static_cast<uint8_t>(rng() % 8);
+
+    // Straddle the block boundaries
+    for (size_t i = 4096 - 2; i + 4 < data.size(); i += 4096)
+        std::memcpy(&data[i], "\x10\x20\x30\x40", 4);
+
+    const mem::pattern pattern("10 20 ? 40");
+    const mem::auto_scanner scanner(pattern);
+
+    mem::memory_scanner memory(mem::get_default_accessor());
+    mem::scan_config config(data.data(), data.data() + data.size(), mem::prot_flags::RW, 4096);
+
+    std::vector<size_t> expected = naive_scan_all(pattern, data);
+    REQUIRE(expected.size() == 15);
+
+    std::vector<size_t> results;
+
+    for (mem::pointer result : memory.scan(scanner, config))
+        results.push_back(static_cast<size_t>(result - data.data()));
+
+    CHECK(results == expected);
+    CHECK(memory.scan_count(scanner, config) == expected.size());
+
+    const std::vector<mem::pointer> first = memory.scan_first(scanner, config, 3);
+    REQUIRE(first.size() == 3);
+    CHECK(first[2] == mem::pointer(data.data() + expected[2]));
+
+    mem::pointer buffer[4];
+    CHECK(memory.scan_into(scanner, config, buffer, 4) == expected.size());
+    CHECK(buffer[3] == mem::pointer(data.data() + expected[3]));
+
+    // Only the hits fully inside the given ranges
+    mem::scan_config ranged(mem::region_set {mem::region(data.data() + 4000, 8000), mem::region(data.data() + 40000, 100)},
+        mem::prot_flags::RW, 4096);
+
+    results.clear();
+
+    for (mem::pointer result : memory.scan(scanner, ranged))
+        results.push_back(static_cast<size_t>(result - data.data()));
+
+    CHECK(results == std::vector<size_t> {4094, 8190});
+
+    const mem::region_set spans = memory.matching_regions(ranged);
+    CHECK(spans.total_size() == 8100);
+
+    // Read buffers go back to the pool after each scan
+    mem::buffer_pool pool(mem::buffer_pages::transparent_huge);
+    mem::memory_scanner pooled(mem::get_default_accessor(), pool);
+
+    CHECK(pooled.scan_count(scanner, config) == expected.size());
+    CHECK(pool.cached() == 1);
+    CHECK(pooled.scan_count(scanner, config) == expected.size());
+    CHECK(pool.cached() == 1);
+
+    mem::arena storage;
+    const mem::arena_vector<mem::pointer> stored = memory.scan(scanner, config, storage);
+
+    CHECK(stored.size() == expected.size());
+    CHECK(stored.get_allocator().get_arena() == &storage);
+}
+
+static mem::region make_range(std::uintptr_t start, std::size_t size)
+{
+    return mem::region(start, size);
 }
 
 template <typename T>
-void check_any_pointer()
+void write_at(std::vector<uint8_t>& data, size_t offset, const T& value)
 {
-    mem::pointer result(0x1234);
+    std::memcpy(&data[offset], &value, sizeof(value));
+}
 
-    REQUIRE(result.as<T>() == static_cast<T>(result.any()));
+std::vector<mem::pointer> naive_xrefs(mem::region code, const mem::region_set& targets)
+{
+    const uint8_t* const bytes = code.start.as<const uint8_t*>();
+
+    std::vector<mem::pointer> results;
+
+    for (size_t i = 0; i + 4 <= code.size; ++i)
+    {
+        int32_t disp;
+        std::memcpy(&disp, &bytes[i], sizeof(disp));
+
+        if (targets.contains(mem::pointer(&bytes[i]).add(4) + static_cast<size_t>(static_cast<ptrdiff_t>(disp))))
+            results.push_back(&bytes[i]);
+    }
+
+    return results;
 }
 
-TEST_CASE("mem::pointer any")
+TEST_CASE("mem::xref_scanner")
 {
-    CHECK_NOTHROW(check_any_pointer<uintptr_t>());
-    CHECK_NOTHROW(check_any_pointer<int*>());
-    CHECK_NOTHROW(check_any_pointer<void*>());
+    // Code and targets share one allocation, so every displacement fits in 32 bits. The gap keeps the bytes of
+    // small displacements from reaching a target when read at the wrong offset.
+    std::vector<uint8_t> memory(4099 + 4096 + 64);
+    std::vector<uintptr_t> data(64);
+
+    const mem::region code(memory.data(), 4099);
+    uint8_t* const target = &memory[4099 + 4096];
+
+    std::mt19937 rng(1234);
+    std::generate(memory.begin(), memory.begin() + 4099, [&rng] { return static_cast<uint8_t>(rng()); });
+
+    const auto plant = [&](size_t offset, mem::pointer address) {
+        const ptrdiff_t disp = address - mem::pointer(&memory[offset + 4]);
+        write_at(memory, offset, static_cast<int32_t>(disp));
+    };
+
+    for (size_t offset : std::initializer_list<size_t> {0, 4, 29, 33, 37, 64, 1000, 4095})
+        plant(offset, &target[0]);
+
+    plant(2000, &target[10]);
+    plant(2010, &target[40]);
+    plant(2020, &target[63]);
+
+    const mem::region_set single(mem::region(&target[0], 1));
+    const mem::region_set several {mem::region(&target[0], 1), mem::region(&target[8], 8), mem::region(&target[60], 4)};
+
+    for (const mem::region_set* set : {&single, &several})
+    {
+        const mem::region_set& targets = *set;
+        const mem::xref_scanner scanner(targets);
+
+        std::vector<mem::pointer> results;
+
+        CHECK(!scanner.scan_code(code, [&](const mem::xref& result) {
+            CHECK(result.kind == mem::xref_kind::relative);
+            CHECK(targets.contains(result.target));
+            results.push_back(result.location);
+            return false;
+        }));
+
+        CHECK(results == naive_xrefs(code, targets));
+        CHECK(results.size() == ((set == &single) ? 8 : 10));
+    }
+
+    data[3] = reinterpret_cast<uintptr_t>(&target[0]);
+    data[17] = reinterpret_cast<uintptr_t>(&target[12]);
+    data[18] = reinterpret_cast<uintptr_t>(&target[20]);
+    data[63] = reinterpret_cast<uintptr_t>(&target[60]);
+
+    const mem::xref_scanner scanner(several);
+
+    std::vector<mem::pointer> locations;
+
+    CHECK(!scanner.scan_data(mem::region(data.data(), data.size() * sizeof(uintptr_t)), [&](const mem::xref& result) {
+        CHECK(result.kind == mem::xref_kind::absolute);
+        locations.push_back(result.location);
+        return false;
+    }));
+
+    CHECK(locations == std::vector<mem::pointer> {&data[3], &data[17], &data[63]});
+
+    size_t calls = 0;
+    CHECK(scanner.scan_data(mem::region(data.data(), data.size() * sizeof(uintptr_t)), [&](const mem::xref&) {
+        return ++calls == 2;
+    }));
+    CHECK(calls == 2);
+
+    CHECK(!mem::xref_scanner().scan_code(code, [](const mem::xref&) { return true; }));
 }
 
-void check_hex_conversion(const void* data, size_t length, bool upper_case, bool padded, const char* expected)
+TEST_CASE("mem::pointer_map")
 {
-    REQUIRE(mem::as_hex({ data, length }, upper_case, padded) == expected);
+    std::vector<uintptr_t> root(8), a(8), b(8), c(8);
+
+    // [[[&root[2]] + 24] + 32] + 32 == &c[4]
+    root[2] = reinterpret_cast<uintptr_t>(&a[0]);
+    a[3] = reinterpret_cast<uintptr_t>(&b[1]);
+    b[5] = reinterpret_cast<uintptr_t>(&c[0]);
+    c[1] = reinterpret_cast<uintptr_t>(&c[7]);
+
+    const auto whole = [](std::vector<uintptr_t>& values) {
+        return mem::region(values.data(), values.size() * sizeof(uintptr_t));
+    };
+
+    const mem::region_set sources {whole(root), whole(a), whole(b), whole(c)};
+    const mem::data_accessor& accessor = mem::get_default_accessor();
+
+    for (size_t block_size : std::initializer_list<size_t> {8, 24, 4096})
+    {
+        const mem::pointer_map map = mem::pointer_map::build(accessor, sources, sources, block_size);
+
+        REQUIRE(map.size() == 4);
+        const auto by_value = [](const mem::pointer_map_entry& lhs, const mem::pointer_map_entry& rhs) {
+            return lhs.value < rhs.value;
+        };
+
+        CHECK(std::is_sorted(map.begin(), map.end(), by_value));
+
+        const mem::slice<const mem::pointer_map_entry> into_b = map.pointing_into(whole(b));
+        REQUIRE(into_b.size() == 1);
+        CHECK(into_b.begin()->location == reinterpret_cast<uintptr_t>(&a[3]));
+
+        CHECK(map.pointing_into(whole(c)).size() == 2);
+        CHECK(map.pointing_into(mem::region(&c[1], 8)).empty());
+
+        const mem::region_set roots {whole(root)};
+
+        const std::vector<mem::pointer_path> paths = map.find_paths(&c[4], roots, 3, 32);
+        REQUIRE(paths.size() == 1);
+        CHECK(paths[0].base == &root[2]);
+        CHECK(paths[0].offsets == std::vector<size_t> {24, 32, 32});
+        CHECK(mem::resolve(paths[0], accessor) == &c[4]);
+
+        CHECK(map.find_paths(&c[4], roots, 2, 32).empty());
+        CHECK(map.find_paths(&c[4], roots, 3, 24).empty());
+
+        // Depth one from b's slot already reaches the target through b[5]
+        CHECK(map.find_paths(&c[4], mem::region_set {whole(b)}, 1, 32).size() == 1);
+    }
+
+    // Values outside the targets are dropped
+    CHECK(mem::pointer_map::build(accessor, sources, mem::region_set {whole(c)}).size() == 2);
+
+    const size_t page = mem::page_size();
+
+    mem::byte* const pages = static_cast<mem::byte*>(mem::protect_alloc(page * 3, mem::prot_flags::RW));
+    REQUIRE(pages);
+
+    const uintptr_t first = reinterpret_cast<uintptr_t>(&c[0]);
+    const uintptr_t last = reinterpret_cast<uintptr_t>(&c[1]);
+    std::memcpy(pages + 8, &first, sizeof(first));
+    std::memcpy(pages + page * 2 + 16, &last, sizeof(last));
+
+    REQUIRE(mem::protect_modify(pages + page, page, mem::prot_flags::NONE));
+
+    const mem::region_set mapped = mem::pointer_map::mapped_regions(accessor, mem::prot_flags::RW);
+    CHECK(mapped.contains(pages));
+    CHECK(!mapped.contains(pages + page));
+    CHECK(mapped.contains(pages + page * 2));
+
+    // A block running into the unreadable page keeps what was read before it
+    mem::checked_local_accessor checked;
+    const mem::region_set fenced {mem::region(pages, page * 3)};
+    const mem::pointer_map partial = mem::pointer_map::build(checked, fenced, mem::region_set {whole(c)}, page * 4);
+
+    REQUIRE(partial.size() == 2);
+    CHECK(partial.begin()->location == reinterpret_cast<uintptr_t>(pages + 8));
+
+    mem::protect_free(pages, page * 3);
 }
 
-TEST_CASE("mem::as_hex")
+TEST_CASE("mem::find_strings")
 {
-    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, true,  true, "01 23 45 67 89 AB CD EF"));
-    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, false, true, "01 23 45 67 89 ab cd ef"));
-    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, true,  false, "0123456789ABCDEF"));
-    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, false, false, "0123456789abcdef"));
+    struct expected_string
+    {
+        size_t offset;
+        size_t size;
+        mem::text_encoding encoding;
+        size_t length;
+    };
+
+    std::vector<mem::byte> text(256, 0x00);
+
+    const auto plant = [&text](size_t offset, const char* value, size_t size) {
+        std::memcpy(&text[offset], value, size);
+    };
+
+    plant(27, "Hello, world!", 13);                     // Crosses a block
+    std::fill(&text[50], &text[130], mem::byte('A'));   // Covers a whole block
+    plant(133, "w\0i\0d\0e\0 \0s\0t\0r\0i\0n\0g\0", 22); // Wide, at an odd offset
+    plant(158, "caf\xC3\xA9 \xE2\x82\xAC!", 10);        // The sequence at 160 crosses a block
+    plant(170, "ab\xC0\x80" "cdef", 8);                 // Overlong, splits the run
+    plant(180, "\xFF\xFE\x01", 3);
+    plant(247, "tail end!", 9);                         // Ends the region
+
+    const std::vector<expected_string> all {
+        {27, 13, mem::text_encoding::ASCII, 13},
+        {50, 80, mem::text_encoding::ASCII, 80},
+        {133, 22, mem::text_encoding::UTF16LE, 11},
+        {158, 10, mem::text_encoding::UTF8, 7},
+        {174, 4, mem::text_encoding::ASCII, 4},
+        {247, 9, mem::text_encoding::ASCII, 9},
+    };
+
+    // Shifting the region moves every run across the SIMD block boundaries
+    for (size_t shift = 0; shift < 40; ++shift)
+    {
+        std::vector<mem::byte> buffer(shift, 0x00);
+        buffer.insert(buffer.end(), text.begin(), text.end());
+
+        const mem::region range(buffer.data() + shift, text.size());
+
+        const auto check = [&](std::vector<mem::found_string> found, const std::vector<expected_string>& wanted) {
+            REQUIRE(found.size() == wanted.size());
+
+            // Narrow and wide runs are not merged into address order
+            std::sort(found.begin(), found.end(), [](const mem::found_string& lhs, const mem::found_string& rhs) {
+                return lhs.range.start < rhs.range.start;
+            });
+
+            for (size_t i = 0; i < wanted.size(); ++i)
+            {
+                CHECK(found[i].range.start == range.start.add(wanted[i].offset));
+                CHECK(found[i].range.size == wanted[i].size);
+                CHECK(found[i].encoding == wanted[i].encoding);
+                CHECK(found[i].length == wanted[i].length);
+            }
+        };
+
+        check(mem::find_strings(range), all);
+        check(mem::find_strings(range, 10), {all[0], all[1], all[2]});
+        check(mem::find_strings(range, 4, mem::text_encoding::ASCII), {all[0], all[1], all[4], all[5]});
+        check(mem::find_strings(range, 4, mem::text_encoding::UTF16LE), {all[2]});
+
+        size_t calls = 0;
+        CHECK(mem::find_strings(range, 4, mem::text_encoding::ANY_ENCODING, [&calls](const mem::found_string&) {
+            return ++calls == 2;
+        }));
+        CHECK(calls == 2);
+    }
+}
+
+TEST_CASE("mem::find_text")
+{
+    std::vector<mem::byte> data(300, 0x00);
+
+    std::memcpy(&data[10], "GetProcAddress", 14);
+    std::memcpy(&data[100], "getprocaddress", 14);
+    std::memcpy(&data[150], "G\0e\0t\0P\0r\0o\0c\0A\0d\0d\0r\0e\0s\0s\0", 28);
+    std::memcpy(&data[200], "GETPROCADDRESS", 14);
+    std::memcpy(&data[250], "GetProc@ddress", 14);
+
+    const mem::region range(data.data(), data.size());
+
+    CHECK(mem::find_text(range, "GetProcAddress") == std::vector<mem::pointer> {&data[10]});
+
+    mem::text_options options;
+    options.ignore_case = true;
+
+    CHECK(mem::find_text(range, "GetProcAddress", options) ==
+        std::vector<mem::pointer> {&data[10], &data[100], &data[200]});
+
+    options.encoding = mem::text_encoding::UTF16LE;
+    CHECK(mem::find_text(range, "getPROCaddress", options) == std::vector<mem::pointer> {&data[150]});
+
+    options.ignore_case = false;
+    CHECK(mem::find_text(range, "getprocaddress", options).empty());
+
+    // Non-ASCII text becomes UTF-16 code units, with a surrogate pair outside the BMP
+    std::memcpy(&data[50], "\xDF\x00\xFC\x00\x3D\xD8\x00\xDE", 8);
+    CHECK(mem::find_text(range, "\xC3\x9F\xC3\xBC\xF0\x9F\x98\x80", options) ==
+        std::vector<mem::pointer> {&data[50]});
+}
+
+TEST_CASE("mem::region_set")
+{
+    mem::region_set set {make_range(0x1000, 0x1000), make_range(0x3000, 0x1000), make_range(0x2000, 0x800)};
+
+    REQUIRE(set.size() == 2);
+    CHECK(set[0].start == 0x1000);
+    CHECK(set[0].size == 0x1800);
+    CHECK(set[1].start == 0x3000);
+    CHECK(set.total_size() == 0x2800);
+
+    CHECK(set.contains(mem::pointer(0x1000)));
+    CHECK(set.contains(mem::pointer(0x27FF)));
+    CHECK_FALSE(set.contains(mem::pointer(0x2800)));
+    CHECK_FALSE(set.contains(mem::pointer(0x0FFF)));
+    CHECK(set.find(mem::pointer(0x3FFF)) == &set[1]);
+    CHECK(set.find(mem::pointer(0x4000)) == nullptr);
+
+    CHECK(set.contains(make_range(0x1800, 0x800)));
+    CHECK_FALSE(set.contains(make_range(0x2000, 0x1000)));
+    CHECK(set.intersects(make_range(0x2700, 0x1000)));
+    CHECK_FALSE(set.intersects(make_range(0x2800, 0x800)));
+
+    set.insert(make_range(0x2800, 0x800));
+    REQUIRE(set.size() == 1);
+    CHECK(set[0].size == 0x3000);
+
+    set.erase(make_range(0x1800, 0x1000));
+    CHECK(set == mem::region_set({make_range(0x1000, 0x800), make_range(0x2800, 0x1800)}));
+
+    const mem::region_set other {make_range(0x0, 0x1200), make_range(0x3000, 0x2000)};
+
+    CHECK((set | other) == mem::region_set({make_range(0x0, 0x1800), make_range(0x2800, 0x2800)}));
+    CHECK((set & other) == mem::region_set({make_range(0x1000, 0x200), make_range(0x3000, 0x1000)}));
+    CHECK((set - other) == mem::region_set({make_range(0x1200, 0x600), make_range(0x2800, 0x800)}));
+    CHECK((other - set) == mem::region_set({make_range(0x0, 0x1000), make_range(0x4000, 0x1000)}));
+
+    std::vector<std::uintptr_t> starts;
+
+    for (const mem::region& range : set)
+        starts.push_back(range.start.as<std::uintptr_t>());
+
+    CHECK(starts == std::vector<std::uintptr_t> {0x1000, 0x2800});
+
+    set.clear();
+    CHECK(set.empty());
+}
+
+#if defined(__unix__)
+
+std::vector<uint8_t> make_elf_image(bool relocated)
+{
+    std::vector<uint8_t> data(0x300);
+
+    const std::uintptr_t base = relocated ? reinterpret_cast<std::uintptr_t>(data.data()) : 0;
+
+    ElfW(Ehdr) ehdr {};
+    std::memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+    ehdr.e_phoff = 0x40;
+    ehdr.e_phentsize = sizeof(ElfW(Phdr));
+    ehdr.e_phnum = 2;
+    ehdr.e_shentsize = sizeof(ElfW(Shdr));
+    write_at(data, 0, ehdr);
+
+    ElfW(Phdr) load {};
+    load.p_type = PT_LOAD;
+    load.p_filesz = load.p_memsz = data.size();
+    write_at(data, 0x40, load);
+
+    ElfW(Phdr) dynamic {};
+    dynamic.p_type = PT_DYNAMIC;
+    dynamic.p_offset = dynamic.p_vaddr = 0x240;
+    dynamic.p_filesz = dynamic.p_memsz = 5 * sizeof(ElfW(Dyn));
+    write_at(data, 0x40 + sizeof(ElfW(Phdr)), dynamic);
+
+    const char strings[] = "\0alpha\0beta\0gamma";
+    std::memcpy(&data[0x180], strings, sizeof(strings));
+
+    const struct
+    {
+        ElfW(Word) name;
+        unsigned char bind;
+        ElfW(Half) shndx;
+        ElfW(Addr) value;
+    } symbols[] {{0, 0, 0, 0}, {1, STB_GLOBAL, 1, 0x200}, {7, STB_GLOBAL, SHN_UNDEF, 0}, {12, STB_WEAK, 1, 0x210}};
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        ElfW(Sym) sym {};
+        sym.st_name = symbols[i].name;
+        sym.st_info = static_cast<unsigned char>(ELF32_ST_INFO(symbols[i].bind, STT_FUNC));
+        sym.st_shndx = symbols[i].shndx;
+        sym.st_value = symbols[i].value;
+        write_at(data, 0x100 + i * sizeof(ElfW(Sym)), sym);
+    }
+
+    // One bucket chaining 3 -> 2 -> 1
+    const uint32_t hash[] {1, 4, 3, 0, 0, 1, 2};
+    write_at(data, 0x1C0, hash);
+
+    const ElfW(Sxword) tags[] {DT_HASH, DT_SYMTAB, DT_STRTAB, DT_STRSZ, DT_NULL};
+    const ElfW(Addr) values[] {base + 0x1C0, base + 0x100, base + 0x180, sizeof(strings), 0};
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ElfW(Dyn) dyn {};
+        dyn.d_tag = tags[i];
+        dyn.d_un.d_ptr = values[i];
+        write_at(data, 0x240 + i * sizeof(ElfW(Dyn)), dyn);
+    }
+
+    return data;
+}
+
+void check_elf_exports(mem::module image, mem::image_layout layout, const mem::data_accessor* accessor)
+{
+    REQUIRE(image.find_export("alpha", layout, accessor) == image.start + 0x200);
+    REQUIRE(image.find_export("gamma", layout, accessor) == image.start + 0x210);
+    REQUIRE(!image.find_export("beta", layout, accessor));
+    REQUIRE(!image.find_export("delta", layout, accessor));
+
+    std::vector<std::string> names;
+
+    image.enum_exports(
+        [&](const char* name, uint32_t, mem::pointer address) {
+            names.push_back(name);
+            REQUIRE(address == image.find_export(name, layout, accessor));
+            return false;
+        },
+        layout, accessor);
+
+    REQUIRE(names == std::vector<std::string> {"alpha", "gamma"});
+}
+
+TEST_CASE("mem::module ELF exports")
+{
+    for (bool relocated : {false, true})
+    {
+        std::vector<uint8_t> data = make_elf_image(relocated);
+        mem::module image(data.data(), data.size());
+
+        CHECK_NOTHROW(check_elf_exports(image, mem::image_layout::mapped, nullptr));
+        CHECK_NOTHROW(check_elf_exports(image, mem::image_layout::mapped, &mem::get_default_accessor()));
+
+        if (!relocated)
+            CHECK_NOTHROW(check_elf_exports(image, mem::image_layout::file, nullptr));
+    }
+
+    mem::module libc = mem::module::named("libc.so.6");
+    REQUIRE(libc.size);
+
+    const mem::pointer getpid_export = libc.find_export("getpid");
+    CHECK(getpid_export == mem::pointer(&getpid));
+    CHECK(libc.find_export("getpid", mem::image_layout::mapped, &mem::get_default_accessor()) == getpid_export);
+    CHECK(!libc.find_export("mem_no_such_export"));
+
+    // Parsed once, for any number of lookups
+    const mem::elf_exports exports(libc);
+    REQUIRE(exports);
+    CHECK(exports.find("getpid") == getpid_export);
+    CHECK(exports.find("getppid") == mem::pointer(&getppid));
+    CHECK(!exports.find("mem_no_such_export"));
+
+    size_t count = 0;
+    bool found = false;
+
+    libc.enum_exports([&](const char* name, uint32_t, mem::pointer address) {
+        ++count;
+
+        if (!std::strcmp(name, "getpid"))
+            found = address == getpid_export;
+
+        return false;
+    });
+
+    CHECK(found);
+    CHECK(count > 1000);
+}
+
+TEST_CASE("mem::module_list")
+{
+    const mem::module_list modules = mem::module_list::snapshot();
+
+    REQUIRE(!modules.empty());
+    CHECK(!modules.stale());
+
+    const mem::module_entry* libc = modules.find("libc.so.6");
+    REQUIRE(libc);
+    CHECK(libc->image.start == mem::module::named("libc.so.6").start);
+    CHECK(modules.find(mem::pointer(&getpid)) == libc);
+
+    const mem::module_entry* main = modules.find(nullptr);
+    REQUIRE(main);
+    CHECK(main->path.empty());
+    CHECK(main->image.start == mem::module::main().start);
+    CHECK(modules.find(mem::pointer(&make_elf_image)) == main);
+
+    CHECK(!modules.find("mem_no_such_module.so"));
+    CHECK(!modules.find(mem::pointer(nullptr)));
+
+    for (const mem::module_entry& entry : modules)
+        CHECK(modules.find(entry.image.start.add(entry.image.size - 1))->image.start == entry.image.start);
+
+    const std::shared_ptr<const mem::module_list> cached = mem::module_list::cached();
+    REQUIRE(cached);
+    CHECK(cached == mem::module_list::cached());
+    CHECK(cached->size() == modules.size());
+}
+
+struct rtti_base
+{
+    virtual ~rtti_base();
+};
+
+struct rtti_other
+{
+    virtual ~rtti_other();
+    virtual int value() const;
+};
+
+struct rtti_single : rtti_base
+{
+    ~rtti_single() override;
+};
+
+struct rtti_multiple : rtti_base, rtti_other
+{
+    ~rtti_multiple() override;
+    int value() const override;
+};
+
+rtti_base::~rtti_base() = default;
+rtti_other::~rtti_other() = default;
+int rtti_other::value() const
+{
+    return 1;
+}
+rtti_single::~rtti_single() = default;
+rtti_multiple::~rtti_multiple() = default;
+int rtti_multiple::value() const
+{
+    return 2;
+}
+
+template <typename T>
+mem::pointer vptr_of(const T& object)
+{
+    return *reinterpret_cast<void* const*>(&object);
+}
+
+TEST_CASE("mem::rtti::itanium_index")
+{
+    const mem::rtti::itanium_index index(mem::module::self());
+
+    REQUIRE(!index.empty());
+
+    const mem::rtti::itanium_type* base = index.find("9rtti_base");
+    REQUIRE(base);
+    CHECK(base->type_info == &typeid(rtti_base));
+    CHECK(base->kind == mem::rtti::itanium_kind::class_type);
+    CHECK(base->bases.empty());
+    CHECK(base->vtable() == vptr_of(rtti_base()));
+    CHECK(index.find(typeid(rtti_base)) == base);
+
+    const mem::rtti::itanium_type* single = index.find(typeid(rtti_single));
+    REQUIRE(single);
+    CHECK(!std::strcmp(single->name, "11rtti_single"));
+    CHECK(single->kind == mem::rtti::itanium_kind::si_class_type);
+    CHECK(single->bases == std::vector<const void*> {&typeid(rtti_base)});
+    CHECK(single->vtable() == vptr_of(rtti_single()));
+
+    const rtti_multiple multiple;
+    const mem::rtti::itanium_type* derived = index.find("13rtti_multiple");
+    REQUIRE(derived);
+    CHECK(derived->kind == mem::rtti::itanium_kind::vmi_class_type);
+    CHECK(derived->bases == std::vector<const void*> {&typeid(rtti_base), &typeid(rtti_other)});
+    CHECK(derived->vtable() == vptr_of(multiple));
+    REQUIRE(derived->vtables.size() == 2);
+    CHECK(std::count(derived->vtables.begin(), derived->vtables.end(),
+              vptr_of(static_cast<const rtti_other&>(multiple))) == 1);
+
+    CHECK(!index.find("15mem_no_such_type"));
+}
+#endif
+
+// File layout: headers, .text at 0x200 and .rdata (holding the export directory and RTTI) at 0x400
+std::vector<uint8_t> make_pe_file()
+{
+    std::vector<uint8_t> data(0x800);
+
+    const auto rdata = [](size_t rva) { return 0x400 + rva - 0x2000; };
+
+    mem::pe::dos_header dos {};
+    dos.e_magic = mem::pe::dos_signature;
+    dos.e_lfanew = 0x80;
+    write_at(data, 0, dos);
+    write_at(data, 0x80, mem::pe::nt_signature);
+
+    mem::pe::file_header file {};
+    file.Machine = 0x8664;
+    file.NumberOfSections = 2;
+    file.SizeOfOptionalHeader = sizeof(mem::pe::optional_header64);
+    write_at(data, 0x84, file);
+
+    mem::pe::optional_header64 optional {};
+    optional.Magic = mem::pe::optional_magic64;
+    optional.AddressOfEntryPoint = 0x1000;
+    optional.ImageBase = 0x140000000;
+    optional.SizeOfImage = 0x3000;
+    optional.SizeOfHeaders = 0x200;
+    optional.NumberOfRvaAndSizes = mem::pe::directory_count;
+    optional.DataDirectory[mem::pe::directory_export] = {0x2000, 0x100};
+    write_at(data, 0x98, optional);
+
+    mem::pe::section_header sections[2] {};
+    std::memcpy(sections[0].Name, ".text", 5);
+    sections[0].VirtualSize = 0x100;
+    sections[0].VirtualAddress = 0x1000;
+    sections[0].SizeOfRawData = 0x200;
+    sections[0].PointerToRawData = 0x200;
+    sections[0].Characteristics = mem::pe::scn_cnt_code | mem::pe::scn_mem_execute | mem::pe::scn_mem_read;
+    std::memcpy(sections[1].Name, ".rdata", 6);
+    sections[1].VirtualSize = 0x400;
+    sections[1].VirtualAddress = 0x2000;
+    sections[1].SizeOfRawData = 0x400;
+    sections[1].PointerToRawData = 0x400;
+    sections[1].Characteristics = mem::pe::scn_mem_read;
+    write_at(data, 0x98 + sizeof(optional), sections);
+
+    mem::pe::export_directory exports {};
+    exports.Name = 0x206C;
+    exports.Base = 5;
+    exports.NumberOfFunctions = 4;
+    exports.NumberOfNames = 3;
+    exports.AddressOfFunctions = 0x2028;
+    exports.AddressOfNames = 0x2038;
+    exports.AddressOfNameOrdinals = 0x2044;
+    write_at(data, rdata(0x2000), exports);
+
+    // alpha, gamma, a forwarded beta and an unnamed export
+    const uint32_t functions[] {0x1000, 0x1010, 0x2061, 0x1020};
+    const uint32_t names[] {0x2050, 0x2056, 0x205B};
+    const uint16_t ordinals[] {0, 2, 1};
+    const char strings[] = "alpha\0beta\0gamma\0other.beta\0test.dll";
+    write_at(data, rdata(0x2028), functions);
+    write_at(data, rdata(0x2038), names);
+    write_at(data, rdata(0x2044), ordinals);
+    write_at(data, rdata(0x2050), strings);
+
+    // Type descriptors: vftable, spare, name
+    write_at(data, rdata(0x2110), ".?AVBase@ns@@");
+    write_at(data, rdata(0x2140), ".?AVDerived@@");
+    write_at(data, rdata(0x2170), ".?AUOther@@");
+
+    // Class hierarchy of Derived, its base class array and base class descriptors
+    const uint32_t hierarchy[] {0, 1, 3, 0x21A0};
+    const uint32_t bases[] {0x21B0, 0x21D0, 0x21F0};
+    const uint32_t descriptors[3][7] {{0x2130, 2, 0, 0xFFFFFFFF, 0, 0x40, 0x2190},
+        {0x2100, 0, 0, 0xFFFFFFFF, 0, 0x40, 0}, {0x2160, 0, 8, 0xFFFFFFFF, 0, 0x40, 0}};
+    write_at(data, rdata(0x2190), hierarchy);
+    write_at(data, rdata(0x21A0), bases);
+    write_at(data, rdata(0x21B0), descriptors[0]);
+    write_at(data, rdata(0x21D0), descriptors[1]);
+    write_at(data, rdata(0x21F0), descriptors[2]);
+
+    // Complete object locators of both Derived vtables
+    const uint32_t locators[2][6] {{1, 0, 0, 0x2130, 0x2190, 0x2210}, {1, 8, 0, 0x2130, 0x2190, 0x2230}};
+    write_at(data, rdata(0x2210), locators[0]);
+    write_at(data, rdata(0x2230), locators[1]);
+
+    // Vtables, preceded by their locator, and a pointer to a type descriptor which is not a locator
+    const uint64_t vtables[] {0x140002210, 0x140001000, 0x140001010, 0, 0x140002230, 0x140001020, 0, 0x140002100};
+    write_at(data, rdata(0x2250), vtables);
+
+    return data;
+}
+
+std::vector<uint8_t> map_pe_file(const std::vector<uint8_t>& file)
+{
+    std::vector<uint8_t> data(0x3000);
+
+    std::memcpy(&data[0], &file[0], 0x200);
+    std::memcpy(&data[0x1000], &file[0x200], 0x100);
+    std::memcpy(&data[0x2000], &file[0x400], 0x400);
+
+    return data;
+}
+
+void check_pe_image(const std::vector<uint8_t>& data, mem::image_layout layout)
+{
+    const mem::pe_image image(mem::region(data.data(), data.size()), layout);
+    const mem::pointer base = data.data();
+    const size_t text = (layout == mem::image_layout::mapped) ? 0x1000 : 0x200;
+
+    REQUIRE(image);
+    REQUIRE(image.is_64());
+    REQUIRE(image.machine() == 0x8664);
+    REQUIRE(image.image_base() == 0x140000000);
+    REQUIRE(image.entry_point() == 0x1000);
+    REQUIRE(image.sections().size() == 2);
+
+    REQUIRE(image.find_section(".text") == &image.sections()[0]);
+    REQUIRE(image.find_section(".rdata") == &image.sections()[1]);
+    REQUIRE(!image.find_section(".data"));
+    REQUIRE(!image.find_section(".tex"));
+    REQUIRE(image.section_from_rva(0x2010) == &image.sections()[1]);
+    REQUIRE(!image.section_from_rva(0x3000));
+
+    REQUIRE(image.rva_to_pointer(0x1010) == base + text + 0x10);
+    REQUIRE(!image.rva_to_pointer(0x2FFF, 2));
+
+    REQUIRE(image.find_export("alpha") == base + text);
+    REQUIRE(image.find_export("gamma") == base + text + 0x10);
+    REQUIRE(!image.find_export("beta"));
+    REQUIRE(!image.find_export("aardvark"));
+    REQUIRE(!image.find_export("delta"));
+    REQUIRE(!image.find_export("zebra"));
+
+    mem::pe_export forwarded;
+    REQUIRE(image.find_export("beta", forwarded));
+    REQUIRE(forwarded.ordinal == 7);
+    REQUIRE(forwarded.forwarder == std::string("other.beta"));
+
+    mem::pe_export unnamed;
+    REQUIRE(image.find_export(static_cast<uint16_t>(8), unnamed));
+    REQUIRE(!unnamed.name);
+    REQUIRE(unnamed.rva == 0x1020);
+    REQUIRE(!image.find_export(static_cast<uint16_t>(4), unnamed));
+    REQUIRE(!image.find_export(static_cast<uint16_t>(9), unnamed));
+
+    std::vector<std::pair<std::string, uint16_t>> exports;
+
+    image.enum_exports([&](const char* name, uint16_t ordinal, mem::pointer) {
+        exports.emplace_back(name ? name : "", ordinal);
+        return false;
+    });
+
+    REQUIRE(exports ==
+        std::vector<std::pair<std::string, uint16_t>> {{"alpha", 5}, {"gamma", 6}, {"beta", 7}, {"", 8}});
+
+    std::vector<std::pair<mem::pointer, mem::prot_flags>> segments;
+
+    image.enum_segments([&](mem::region range, mem::prot_flags prot) {
+        REQUIRE(range.size == (segments.empty() ? 0x100 : 0x400));
+        segments.emplace_back(range.start, prot);
+        return false;
+    });
+
+    REQUIRE(segments.size() == 2);
+    REQUIRE(segments[0].first == base + text);
+    REQUIRE(segments[0].second == mem::prot_flags::RX);
+    REQUIRE(segments[1].second == mem::prot_flags::R);
+}
+
+TEST_CASE("mem::pe_image")
+{
+    const std::vector<uint8_t> file = make_pe_file();
+
+    CHECK_NOTHROW(check_pe_image(file, mem::image_layout::file));
+    CHECK_NOTHROW(check_pe_image(map_pe_file(file), mem::image_layout::mapped));
+
+    CHECK(!mem::pe_image(mem::region(file.data(), 0x100), mem::image_layout::file));
+    CHECK(!mem::pe_image(mem::region(file.data() + 1, file.size() - 1), mem::image_layout::file));
+
+    // Export counts which run past the image disable exports, instead of allocating or looping on them
+    std::vector<uint8_t> huge_exports = file;
+    write_at(huge_exports, 0x400 + offsetof(mem::pe::export_directory, NumberOfFunctions), uint32_t(0xFFFFFFFF));
+
+    const mem::pe_image huge_image(mem::region(huge_exports.data(), huge_exports.size()), mem::image_layout::file);
+    REQUIRE(huge_image);
+
+    size_t exported = 0;
+    huge_image.enum_exports([&](const char*, uint16_t, mem::pointer) { return ++exported, false; });
+    CHECK(exported == 0);
+    CHECK(!huge_image.find_export("alpha"));
+
+    // An optional header with only the export directory, directly followed by the section headers
+    std::vector<uint8_t> short_header = file;
+    const size_t optional_size = offsetof(mem::pe::optional_header64, DataDirectory) + sizeof(mem::pe::data_directory);
+    write_at(short_header, 0x84 + offsetof(mem::pe::file_header, SizeOfOptionalHeader), uint16_t(optional_size));
+    std::memmove(&short_header[0x98 + optional_size], &file[0x98 + sizeof(mem::pe::optional_header64)],
+        2 * sizeof(mem::pe::section_header));
+
+    const mem::pe_image short_image(mem::region(short_header.data(), short_header.size()), mem::image_layout::file);
+    REQUIRE(short_image);
+    CHECK(short_image.sections().size() == 2);
+    CHECK(short_image.directory(mem::pe::directory_export).VirtualAddress == 0x2000);
+
+    for (size_t i = 1; i < mem::pe::directory_count; ++i)
+        CHECK(short_image.directory(i).VirtualAddress == 0);
+
+    CHECK(short_image.find_export("alpha") == short_image.rva_to_pointer(0x1000));
+}
+
+void check_rtti_index(const std::vector<uint8_t>& data, mem::image_layout layout)
+{
+    const mem::rtti::rtti_index index(mem::pe_image(mem::region(data.data(), data.size()), layout));
+
+    REQUIRE(index.size() == 1);
+    REQUIRE(!index.find(".?AVBase@ns@@"));
+
+    const mem::rtti::rtti_type* derived = index.find(".?AVDerived@@");
+    REQUIRE(derived);
+    REQUIRE(derived->type_descriptor == 0x2130);
+    REQUIRE(derived->bases ==
+        std::vector<const char*> {index.image().string_at(0x2110), index.image().string_at(0x2170)});
+
+    REQUIRE(derived->vtables.size() == 2);
+    REQUIRE(derived->vtables[0].rva == 0x2258);
+    REQUIRE(derived->vtables[0].locator == 0x2210);
+    REQUIRE(derived->vtables[0].offset == 0);
+    REQUIRE(derived->vtables[1].rva == 0x2278);
+    REQUIRE(derived->vtables[1].offset == 8);
+    REQUIRE(index.image().rva_to_pointer(0x2258, 8).at<const uint64_t>(0) == 0x140001000);
+
+    REQUIRE(index.find_demangled("Derived") == derived);
+    REQUIRE(!index.find_demangled("ns::Base"));
+}
+
+TEST_CASE("mem::rtti::rtti_index")
+{
+    const std::vector<uint8_t> file = make_pe_file();
+
+    CHECK_NOTHROW(check_rtti_index(file, mem::image_layout::file));
+    CHECK_NOTHROW(check_rtti_index(map_pe_file(file), mem::image_layout::mapped));
+
+    CHECK(mem::rtti::rtti_index::demangle(".?AVBase@ns@@") == "ns::Base");
+    CHECK(mem::rtti::rtti_index::demangle(".?AUOther@@") == "Other");
+    CHECK(mem::rtti::rtti_index::demangle(".?AVFoo@?A0x1a2b3c4d@@") == "`anonymous namespace'::Foo");
+    CHECK(mem::rtti::rtti_index::demangle(".?AV?$vector@H@std@@") == ".?AV?$vector@H@std@@");
+}
+
+TEST_CASE("mem::region contains")
+{
+    REQUIRE(mem::region(0x1234, 0x10).contains(mem::region(0x1234, 0x10)));
+    REQUIRE(mem::region(0x1234, 0x10).contains(mem::region(0x1235, 0x09)));
+    REQUIRE(!mem::region(0x1234, 0x10).contains(mem::region(0x1235, 0x10)));
+
+    REQUIRE(mem::region(0x1234, 0x10).contains(0x1234, 0x10));
+    REQUIRE(mem::region(0x1234, 0x10).contains(0x1235, 0x09));
+    REQUIRE(!mem::region(0x1234, 0x10).contains(0x1235, 0x10));
+
+    REQUIRE(mem::region(0x1234, 0x10).contains(0x1234));
+    REQUIRE(mem::region(0x1234, 0x10).contains(0x1234 + 0x9));
+    REQUIRE(mem::region(0x1234, 1).contains(0x1234));
+    REQUIRE(!mem::region(0x1234, 0x10).contains(0x1233));
+    REQUIRE(!mem::region(0x1234, 0x10).contains(0x1234 + 0x10));
+    REQUIRE(!mem::region(0x1234, 0).contains(0x1234));
+
+    REQUIRE(mem::region(0x1234, 4).contains<int>(0x1234));
+    REQUIRE(mem::region(0x1234, 4).contains<int>(0x1234));
+    REQUIRE(!mem::region(0x1234, 3).contains<int>(0x1234));
+    REQUIRE(!mem::region(0x1235, 3).contains<int>(0x1234));
+}
+
+void check_pointer_aligment(mem::pointer address, size_t alignment, mem::pointer aligned_down, mem::pointer aligned_up)
+{
+    REQUIRE(address.align_down(alignment) == aligned_down);
+    REQUIRE(address.align_up(alignment) == aligned_up);
+}
+
+TEST_CASE("mem::pointer align")
+{
+    CHECK_NOTHROW(check_pointer_aligment(13, 1, 13, 13));
+    CHECK_NOTHROW(check_pointer_aligment(13, 2, 12, 14));
+    CHECK_NOTHROW(check_pointer_aligment(13, 5, 10, 15));
+    CHECK_NOTHROW(check_pointer_aligment(16, 5, 15, 20));
+    CHECK_NOTHROW(check_pointer_aligment(14, 5, 10, 15));
+    CHECK_NOTHROW(check_pointer_aligment(15, 15, 15, 15));
+}
+
+template <typename T>
+void check_any_pointer()
+{
+    mem::pointer result(0x1234);
+
+    REQUIRE(result.as<T>() == static_cast<T>(result.any()));
+}
+
+TEST_CASE("mem::pointer any")
+{
+    CHECK_NOTHROW(check_any_pointer<uintptr_t>());
+    CHECK_NOTHROW(check_any_pointer<int*>());
+    CHECK_NOTHROW(check_any_pointer<void*>());
+}
+
+TEST_CASE("mem::is_ascii is_utf8")
+{
+    std::vector<mem::byte> data(300, 'a');
+
+    const mem::region range(data.data(), data.size());
+
+    CHECK(mem::is_ascii(range));
+    CHECK(mem::is_utf8(range));
+
+    // Non-ASCII at every position, including the scalar tail
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = 0x80;
+        CHECK(!mem::is_ascii(range));
+        CHECK(!mem::is_utf8(range));
+        data[i] = 'a';
+    }
+
+    for (size_t i = 0; i + 3 <= data.size(); i += 7)
+    {
+        std::memcpy(&data[i], "\xE2\x82\xAC", 3);
+        CHECK(!mem::is_ascii(range));
+        CHECK(mem::is_utf8(range));
+    }
+
+    // Truncated sequences
+    CHECK(!mem::is_utf8(mem::region(data.data(), 1)));
+    CHECK(!mem::is_utf8(mem::region(data.data(), 2)));
+    CHECK(mem::is_ascii(mem::region(data.data(), 0)));
+}
+
+void check_hex_conversion(const void* data, size_t length, bool upper_case, bool padded, const char* expected)
+{
+    REQUIRE(mem::as_hex({ data, length }, upper_case, padded) == expected);
+}
+
+TEST_CASE("mem::arena")
+{
+    mem::arena storage(1);
+
+    const std::size_t page = mem::page_size();
+
+    CHECK(storage.reserved() == 0);
+
+    const auto first = storage.mark();
+
+    void* const small = storage.allocate(3, 1);
+    void* const aligned = storage.allocate(16, 64);
+
+    CHECK(storage.reserved() == page);
+    CHECK((reinterpret_cast<std::uintptr_t>(aligned) & 63) == 0);
+    CHECK(static_cast<char*>(aligned) >= static_cast<char*>(small) + 3);
+
+    const auto second = storage.mark();
+
+    // Larger than a chunk, so it gets its own
+    std::uint32_t* const values = storage.allocate_array<std::uint32_t>(page);
+    std::fill(values, values + page, 0xDEADBEEF);
+    CHECK(storage.reserved() > page * 4);
+
+    storage.reset(second);
+    CHECK(storage.reserved() == page);
+    CHECK(storage.allocate(1, 1) == static_cast<char*>(aligned) + 16);
+
+    storage.reset(first);
+    CHECK(storage.allocate(3, 1) == small);
+
+    // The last chunk is kept for reuse
+    storage.reset();
+    CHECK(storage.reserved() == page);
+    CHECK(storage.allocate(3, 1) == small);
+
+    storage.release();
+    CHECK(storage.reserved() == 0);
+
+    mem::arena moved(std::move(storage));
+
+    mem::arena_vector<int> numbers {mem::arena_allocator<int>(moved)};
+
+    for (int i = 0; i < 1000; ++i)
+        numbers.push_back(i);
+
+    CHECK(numbers[999] == 999);
+    CHECK(moved.reserved() >= 4000);
+
+    // Without an arena, the heap is used
+    mem::arena_vector<int> heap(10, 1);
+    CHECK(heap.get_allocator().get_arena() == nullptr);
+    heap = numbers;
+    CHECK(heap.size() == 1000);
+
+    const std::uint8_t data[] {0x01, 0x02, 0x03, 0x01, 0x02, 0x03};
+    const mem::pattern pattern("01 02");
+
+    const mem::arena_vector<mem::pointer> results =
+        mem::simd_scanner(pattern).scan_all(mem::region(data, sizeof(data)), moved);
+
+    CHECK(results == (mem::arena_vector<mem::pointer> {&data[0], &data[3]}));
+
+    mem::arena_pattern_cache cache(mem::region(data, sizeof(data)), moved);
+    CHECK(cache.scan_all(pattern).size() == 2);
+    CHECK(cache.scan_all(pattern).get_allocator().get_arena() == &moved);
+    CHECK(cache.scan(pattern, 1, 2) == &data[3]);
+
+    // The default cache still hands out plain vectors
+    mem::pattern_cache heap_cache(mem::region(data, sizeof(data)));
+    const std::vector<mem::pointer>& heap_results = heap_cache.scan_all(pattern);
+    CHECK(heap_results == (std::vector<mem::pointer> {&data[0], &data[3]}));
+}
+
+TEST_CASE("mem::buffer_pool")
+{
+    mem::buffer_pool pool(mem::buffer_pages::normal, 2);
+
+    mem::byte* first_data = nullptr;
+
+    {
+        const mem::buffer_pool::buffer first = pool.acquire(100000);
+
+        REQUIRE(first);
+        CHECK(first.size() >= 100000);
+        CHECK((reinterpret_cast<std::uintptr_t>(first.data()) & 63) == 0);
+
+        std::memset(first.data(), 0xCC, first.size());
+        first_data = first.data();
+
+        CHECK(pool.cached() == 0);
+    }
+
+    CHECK(pool.cached() == 1);
+
+    {
+        // Cached buffers are reused as they were left
+        const mem::buffer_pool::buffer again = pool.acquire(5000);
+        CHECK(again.data() == first_data);
+        CHECK(again.data()[99999] == 0xCC);
+
+        // Too large for any cached buffer
+        const mem::buffer_pool::buffer larger = pool.acquire(200000);
+        CHECK(larger.data() != first_data);
+
+        mem::buffer_pool::buffer small = pool.acquire(10);
+        mem::buffer_pool::buffer moved = std::move(small);
+        CHECK(!small);
+        CHECK(moved);
+    }
+
+    // Only the two largest are kept
+    CHECK(pool.cached() == 2);
+    CHECK(pool.acquire(150000).size() >= 200000);
+
+    pool.trim();
+    CHECK(pool.cached() == 0);
+
+    for (mem::buffer_pages pages : {mem::buffer_pages::transparent_huge, mem::buffer_pages::huge_tlb})
+    {
+        mem::buffer_pool huge(pages);
+        const mem::buffer_pool::buffer value = huge.acquire(1000);
+
+        REQUIRE(value);
+        CHECK(value.size() == mem::huge_page_size());
+        CHECK((reinterpret_cast<std::uintptr_t>(value.data()) & (mem::huge_page_size() - 1)) == 0);
+
+        value.data()[value.size() - 1] = 1;
+    }
+
+    CHECK(&mem::buffer_pool::thread_pool() == &mem::buffer_pool::thread_pool());
+}
+
+namespace
+{
+    class counting_accessor : public mem::local_memory_accessor
+    {
+    public:
+        mutable std::size_t protect_calls {0};
+
+        bool protect_modify(
+            void* addr, std::size_t size, mem::prot_flags flags, mem::prot_flags* old_flags = nullptr) const override
+        {
+            ++protect_calls;
+
+            return mem::local_memory_accessor::protect_modify(addr, size, flags, old_flags);
+        }
+
+        mutable std::size_t query_calls {0};
+
+        bool query_regions(void* addr, std::size_t size, std::vector<mem::region_info>& regions) const override
+        {
+            ++query_calls;
+
+            return mem::local_memory_accessor::query_regions(addr, size, regions);
+        }
+    };
+} // namespace
+
+TEST_CASE("mem::code_allocator")
+{
+    counting_accessor accessor;
+    mem::code_allocator allocator(accessor);
+
+    static int anchor = 0;
+    const std::uintptr_t target = reinterpret_cast<std::uintptr_t>(&anchor);
+
+    const auto distance = [target](void* stub) {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(stub);
+        return (address > target) ? address - target : target - address;
+    };
+
+    std::vector<void*> stubs;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        void* const stub = allocator.allocate(32, &anchor);
+
+        REQUIRE(stub);
+        CHECK(distance(stub) < mem::default_code_distance);
+        CHECK((reinterpret_cast<std::uintptr_t>(stub) & 15) == 0);
+
+        stubs.push_back(stub);
+    }
+
+    // Stubs share blocks
+    CHECK(allocator.block_count() == 1);
+    CHECK(mem::protect_query(stubs[0]) == mem::prot_flags::RX);
+
+    // mov eax, i; ret
+    const auto make_code = [](int value) {
+        std::array<mem::byte, 6> code {{0xB8, 0, 0, 0, 0, 0xC3}};
+        std::memcpy(&code[1], &value, sizeof(value));
+        return code;
+    };
+
+    {
+        mem::code_allocator::batch batch(allocator);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            const auto code = make_code(i);
+            CHECK(allocator.write(stubs[static_cast<std::size_t>(i)], code.data(), code.size()));
+        }
+    }
+
+    // Once to make the block writable, once to make it executable again
+    CHECK(accessor.protect_calls == 2);
+    CHECK(mem::protect_query(stubs[0]) == mem::prot_flags::RX);
+
+#if defined(MEM_ARCH_X86_64) || defined(MEM_ARCH_X86)
+    CHECK(mem::pointer(stubs[123]).as<int (*)()>()() == 123);
+#endif
+
+    const auto code = make_code(-1);
+    CHECK(allocator.write(stubs[5], code.data(), code.size()));
+    CHECK(accessor.protect_calls == 4);
+
+    allocator.deallocate(stubs[7], 32);
+    CHECK(allocator.allocate(16, &anchor) == stubs[7]);
+
+    mem::byte outside[16] {};
+    CHECK(!allocator.write(outside, code.data(), code.size()));
+
+    // Larger than a block
+    void* const large = allocator.allocate(0x30000, &anchor);
+    REQUIRE(large);
+    CHECK(distance(large) < mem::default_code_distance);
+    CHECK(allocator.block_count() == 2);
+
+    mem::code_allocator anywhere;
+    CHECK(anywhere.allocate(100) != nullptr);
+}
+
+TEST_CASE("mem::protect_batch")
+{
+    const std::size_t page = mem::page_size();
+
+    mem::byte* const pages = static_cast<mem::byte*>(mem::protect_alloc(page * 8, mem::prot_flags::RW));
+    REQUIRE(pages);
+
+    REQUIRE(mem::protect_modify(pages + page * 2, page * 2, mem::prot_flags::R));
+
+    counting_accessor accessor;
+
+    {
+        mem::protect_batch batch(accessor, mem::prot_flags::R);
+
+        // Many small, unaligned and overlapping sites, leaving page 5 alone
+        for (std::size_t offset = 0; offset < page * 8; offset += 7)
+        {
+            if (offset / page != 5)
+                batch.add({pages + offset, 5});
+        }
+
+        CHECK(batch.apply());
+        CHECK(batch);
+
+        // One snapshot, and one change per merged range
+        CHECK(accessor.query_calls == 1);
+        CHECK(accessor.protect_calls == 2);
+
+        // Split where the old protection differs
+        CHECK(batch.size() == 4);
+
+        CHECK(mem::protect_query(pages) == mem::prot_flags::R);
+        CHECK(mem::protect_query(pages + page * 4) == mem::prot_flags::R);
+        CHECK(mem::protect_query(pages + page * 5) == mem::prot_flags::RW);
+        CHECK(mem::protect_query(pages + page * 7) == mem::prot_flags::R);
+    }
+
+    CHECK(accessor.protect_calls == 6);
+
+    CHECK(mem::protect_query(pages) == mem::prot_flags::RW);
+    CHECK(mem::protect_query(pages + page * 2) == mem::prot_flags::R);
+    CHECK(mem::protect_query(pages + page * 3) == mem::prot_flags::R);
+    CHECK(mem::protect_query(pages + page * 4) == mem::prot_flags::RW);
+    CHECK(mem::protect_query(pages + page * 7) == mem::prot_flags::RW);
+
+    // Overlapping applies restore what was there before the first
+    {
+        mem::protect_batch batch(accessor, mem::prot_flags::NONE);
+
+        batch.add({pages, page * 2});
+        CHECK(batch.apply());
+
+        batch.add({pages + page, page * 2});
+        CHECK(batch.apply());
+
+        CHECK(mem::protect_query(pages + page * 2) == mem::prot_flags::NONE);
+    }
+
+    CHECK(mem::protect_query(pages) == mem::prot_flags::RW);
+    CHECK(mem::protect_query(pages + page) == mem::prot_flags::RW);
+    CHECK(mem::protect_query(pages + page * 2) == mem::prot_flags::R);
+
+    mem::protect_free(pages, page * 8);
+}
+
+#if defined(__unix__)
+TEST_CASE("mem::local_memory_accessor query_region")
+{
+    const std::size_t page = mem::page_size();
+
+    mem::byte* const pages = static_cast<mem::byte*>(mem::protect_alloc(page * 3, mem::prot_flags::R));
+    REQUIRE(pages);
+
+    // Leave an unmapped gap between two mappings
+    REQUIRE(munmap(pages + page, page) == 0);
+
+    const mem::data_accessor& accessor = mem::get_default_accessor();
+
+    mem::region_info info {};
+
+    REQUIRE(accessor.query_region(pages + page + 16, info));
+    CHECK(info.start == pages + page + 16);
+    CHECK(info.size == page - 16);
+    CHECK(info.flags == mem::prot_flags::NONE);
+
+    REQUIRE(accessor.query_region(pages + page * 2, info));
+    CHECK(info.start <= pages + page * 2);
+    CHECK(info.flags == mem::prot_flags::R);
+
+    // Only the mappings themselves
+    std::vector<mem::region_info> regions;
+    REQUIRE(accessor.query_regions(pages, page * 3, regions));
+    REQUIRE(regions.size() == 2);
+    CHECK(regions[0].start == pages);
+    CHECK(regions[0].size == page);
+    CHECK(regions[1].start == pages + page * 2);
+    CHECK(regions[1].size == page);
+
+    munmap(pages, page);
+    munmap(pages + page * 2, page);
+}
+#endif
+
+namespace
+{
+    // Three pages with DE AD BE EF planted either side of the middle page, which cannot be read.
+    // One copy runs across the end of the middle page, so only part of it can be read.
+    class fenced_pages
+    {
+    public:
+        const std::size_t page {mem::page_size()};
+        mem::byte* const pages {static_cast<mem::byte*>(mem::protect_alloc(page * 3, mem::prot_flags::RW))};
+
+        // Every copy which can be read in full
+        std::vector<mem::pointer> expected {};
+
+        fenced_pages();
+        ~fenced_pages();
+
+        fenced_pages(const fenced_pages&) = delete;
+        fenced_pages& operator=(const fenced_pages&) = delete;
+    };
+
+    fenced_pages::fenced_pages()
+    {
+        REQUIRE(pages);
+
+        for (size_t i = 0; i < page * 3; ++i)
+            pages[i] = static_cast<mem::byte>(i * 7);
+
+        const mem::byte needle[4] {0xDE, 0xAD, 0xBE, 0xEF};
+
+        for (size_t offset : {size_t(16), page - 4, page * 2 - 2, page * 2 + 100, page * 3 - 4})
+            std::memcpy(pages + offset, needle, 4);
+
+        expected = {pages + 16, pages + page - 4, pages + page * 2 + 100, pages + page * 3 - 4};
+
+        REQUIRE(mem::protect_modify(pages + page, page, mem::prot_flags::NONE));
+    }
+
+    fenced_pages::~fenced_pages()
+    {
+        if (pages)
+            mem::protect_free(pages, page * 3);
+    }
+} // namespace
+
+TEST_CASE("mem::fault_guard")
+{
+    const fenced_pages fixture;
+
+    const std::size_t page = fixture.page;
+    mem::byte* const pages = fixture.pages;
+
+    const mem::byte needle[4] {0xDE, 0xAD, 0xBE, 0xEF};
+
+    mem::byte buffer[8] {};
+
+    CHECK(mem::safe_read(pages + 16, buffer, 4));
+    CHECK(std::memcmp(buffer, needle, 4) == 0);
+
+    CHECK_FALSE(mem::safe_read(pages + page - 4, buffer, 8));
+    CHECK(mem::fault_guard::fault_address() >= pages + page);
+    CHECK(mem::fault_guard::fault_address() < pages + page * 2);
+
+    // Guards keep working after a fault, and nest
+    CHECK_FALSE(mem::safe_read(pages + page, buffer, 1));
+    CHECK(mem::safe_read(pages + page * 2 + 100, buffer, 4));
+
+    bool inner = true;
+    CHECK(mem::fault_guard::execute([&] { inner = mem::safe_read(pages + page, buffer, 1); }));
+    CHECK_FALSE(inner);
+
+    const std::vector<mem::pointer>& expected = fixture.expected;
+
+    const mem::pattern pattern("DE AD BE EF");
+    const mem::region range(pages, page * 3);
+
+    std::vector<mem::pointer> results;
+
+    CHECK_FALSE(mem::safe_scan(mem::simd_scanner(pattern), range, [&](mem::pointer result) {
+        results.push_back(result);
+        return false;
+    }));
+    CHECK(results == expected);
+
+    results.clear();
+
+    CHECK_FALSE(mem::safe_scan(mem::boyer_moore_scanner(pattern), range, [&](mem::pointer result) {
+        results.push_back(result);
+        return false;
+    }));
+    CHECK(results == expected);
+
+    CHECK(mem::safe_scan(mem::simd_scanner(pattern), range, [&](mem::pointer result) {
+        return result > pages + page;
+    }) == pages + page * 2 + 100);
+}
+
+namespace
+{
+    // Reports a range as readable whatever it really is, like a scan racing with a protection change
+    class stale_query_accessor : public mem::checked_local_accessor
+    {
+    public:
+        mem::region stale {};
+
+        bool query_region(void* addr, mem::region_info& region) const override
+        {
+            if (!stale.contains(addr))
+                return mem::checked_local_accessor::query_region(addr, region);
+
+            region = {stale.start.as<void*>(), stale.size, mem::prot_flags::RW};
+
+            return true;
+        }
+    };
+
+    // Reads all or nothing, and goes back to the default read_partial
+    class guarded_accessor : public stale_query_accessor
+    {
+    public:
+        bool read(void* src, void* dst, std::size_t size) const override
+        {
+            return (size != 0) && mem::safe_read(src, dst, size);
+        }
+
+        std::size_t read_partial(void* src, void* dst, std::size_t size) const override
+        {
+            return mem::data_accessor::read_partial(src, dst, size);
+        }
+    };
+} // namespace
+
+TEST_CASE("mem::checked_local_accessor")
+{
+    const fenced_pages fixture;
+
+    const std::size_t page = fixture.page;
+    mem::byte* const pages = fixture.pages;
+
+    stale_query_accessor accessor;
+    accessor.stale = mem::region(pages, page * 3);
+
+    std::vector<mem::byte> buffer(page * 3);
+
+    CHECK(accessor.read(pages + 8, buffer.data(), 64));
+    CHECK(std::memcmp(buffer.data(), pages + 8, 64) == 0);
+
+    // Cut exactly at the unreadable page
+    CHECK_FALSE(accessor.read(pages + 8, buffer.data(), page));
+    CHECK(accessor.read_partial(pages + 8, buffer.data(), page) == page - 8);
+    CHECK(std::memcmp(buffer.data(), pages + 8, page - 8) == 0);
+
+    CHECK(accessor.read_partial(pages + page + 8, buffer.data(), 16) == 0);
+    CHECK(accessor.read_partial(pages + page * 2, buffer.data(), page) == page);
+    CHECK(accessor.read_partial(pages, buffer.data(), page * 3) == page);
+
+    const mem::pattern pattern("DE AD BE EF");
+    mem::memory_scanner memory(accessor);
+
+    // Blocks which run into the unreadable page are still scanned up to it
+    for (std::size_t block_size : {std::size_t(1000), page, page * 4})
+    {
+        mem::scan_stats stats;
+
+        mem::scan_config config(mem::region_set {mem::region(pages, page * 3)}, mem::prot_flags::RW, block_size);
+        config.stats = &stats;
+
+        CHECK(memory.scan(mem::simd_scanner(pattern), config) == fixture.expected);
+        CHECK(stats.bytes_unreadable == page);
+    }
+
+    // The default read_partial retries a page at a time
+    guarded_accessor guarded;
+    guarded.stale = accessor.stale;
+
+    CHECK(guarded.read_partial(pages + 8, buffer.data(), page * 3) == page - 8);
+    CHECK(guarded.read_partial(pages + page + 8, buffer.data(), 16) == 0);
+
+    {
+        mem::scan_stats stats;
+
+        mem::scan_config config(mem::region_set {mem::region(pages, page * 3)}, mem::prot_flags::RW, page * 4);
+        config.stats = &stats;
+
+        CHECK(mem::memory_scanner(guarded).scan(mem::simd_scanner(pattern), config) == fixture.expected);
+        CHECK(stats.bytes_unreadable == page);
+    }
+}
+
+#if defined(__unix__)
+TEST_CASE("mem::memory_scanner residency")
+{
+    const std::size_t page = mem::page_size();
+
+    mem::byte* const pages = static_cast<mem::byte*>(mem::protect_alloc(page * 64, mem::prot_flags::RW));
+    REQUIRE(pages);
+
+    // Whole huge pages would make untouched pages resident too
+    madvise(pages, page * 64, MADV_NOHUGEPAGE);
+
+    // Only pages 0 to 7 and 32 to 39 are ever touched
+    std::memset(pages, 0x11, page * 8);
+    std::memset(pages + page * 32, 0x11, page * 8);
+
+    const mem::byte needle[4] {0xDE, 0xAD, 0xBE, 0xEF};
+
+    std::memcpy(pages + page * 3 + 10, needle, 4);
+    std::memcpy(pages + page * 8 - 2, needle, 2);
+    std::memcpy(pages + page * 39 + 100, needle, 4);
+
+    const mem::pattern pattern("DE AD BE EF");
+    mem::memory_scanner memory(mem::get_default_accessor());
+
+    mem::scan_stats stats;
+
+    mem::scan_config config(pages, pages + page * 64, mem::prot_flags::RW, page * 4);
+    config.residency = mem::scan_residency::resident;
+    config.stats = &stats;
+
+    const std::vector<mem::pointer> expected {pages + page * 3 + 10, pages + page * 39 + 100};
+
+    CHECK(memory.scan(mem::simd_scanner(pattern), config) == expected);
+    CHECK(stats.bytes_skipped == page * 48);
+    CHECK(stats.bytes_unreadable == 0);
+
+    // Nothing was faulted in
+    std::vector<unsigned char> resident(64);
+    REQUIRE(mincore(pages, page * 64, resident.data()) == 0);
+
+    for (std::size_t i = 0; i < 64; ++i)
+        CHECK((resident[i] & 1) == ((i < 8) || ((i >= 32) && (i < 40))));
+
+    stats = {};
+    config.residency = mem::scan_residency::all;
+
+    CHECK(memory.scan(mem::simd_scanner(pattern), config) == expected);
+    CHECK(stats.bytes_skipped == 0);
+
+    mem::protect_free(pages, page * 64);
+}
+#endif
+
+TEST_CASE("mem::data_buffer")
+{
+    mem::data_buffer<int, 4> small;
+
+    CHECK(small.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i)
+        small.push_back(i);
+
+    const int* const inline_data = small.data();
+
+    CHECK(small.capacity() == 4);
+
+    small.push_back(4);
+    CHECK(small.data() != inline_data);
+    CHECK(small.size() == 5);
+
+    // Appending from itself while growing
+    small.append(small.data(), small.size());
+    REQUIRE(small.size() == 10);
+    CHECK(small[7] == 2);
+
+    small.resize(2);
+    small.shrink_to_fit();
+    CHECK(small.data() == inline_data);
+    CHECK(small.capacity() == 4);
+    CHECK(small[1] == 1);
+
+    mem::data_buffer<int, 4> moved(std::move(small));
+    CHECK(moved.size() == 2);
+    CHECK(moved[1] == 1);
+    CHECK(small.empty());
+
+    mem::data_buffer<mem::byte, 0, 64> aligned;
+
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+        mem::byte* const dest = aligned.append_uninitialized(100);
+        std::memset(dest, static_cast<int>(i), 100);
+
+        CHECK((reinterpret_cast<std::uintptr_t>(aligned.data()) & 63) == 0);
+    }
+
+    REQUIRE(aligned.size() == 2000);
+    CHECK(aligned[1999] == 19);
+
+    mem::data_buffer<mem::byte, 0, 64> copied(aligned);
+    CHECK(std::memcmp(copied.data(), aligned.data(), aligned.size()) == 0);
+
+    copied.resize_uninitialized(10);
+    copied.resize(20);
+    CHECK(copied[9] == 0);
+    CHECK(copied[10] == 0);
+    CHECK(copied[19] == 0);
+
+    copied.swap(aligned);
+    CHECK(aligned.size() == 20);
+    CHECK(copied.size() == 2000);
+
+    // Growth is geometric, so building a buffer one value at a time rarely reallocates
+    mem::byte_buffer bytes;
+    std::size_t reallocations = 0;
+
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+        const mem::byte* const before = bytes.data();
+        bytes.push_back(static_cast<mem::byte>(i));
+        reallocations += (bytes.data() != before);
+    }
+
+    CHECK(reallocations < 40);
+
+    const mem::byte text[] {'a', 'b', 'c'};
+    bytes.assign(text, 3);
+    CHECK(bytes.size() == 3);
+    CHECK(bytes[2] == 'c');
+}
+
+TEST_CASE("mem::as_hex")
+{
+    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, true,  true, "01 23 45 67 89 AB CD EF"));
+    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, false, true, "01 23 45 67 89 ab cd ef"));
+    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, true,  false, "0123456789ABCDEF"));
+    CHECK_NOTHROW(check_hex_conversion("\x01\x23\x45\x67\x89\xAB\xCD\xEF", 8, false, false, "0123456789abcdef"));
+}
+
+TEST_CASE("mem::hex_encode hex_decode")
+{
+    std::mt19937 rng(0x1234);
+
+    std::vector<mem::byte> data(300);
+    std::generate(data.begin(), data.end(), [&rng] { return static_cast<mem::byte>(rng()); });
+
+    const auto scalar_hex = [](const mem::byte* bytes, size_t size, bool upper_case, bool padded) {
+        const char* digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+        std::string result;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (i && padded)
+                result += ' ';
+
+            result += digits[bytes[i] >> 4];
+            result += digits[bytes[i] & 0xF];
+        }
+
+        return result;
+    };
+
+    // Sizes around the SIMD block sizes
+    for (size_t size : std::initializer_list<size_t> {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 300})
+    {
+        for (bool upper_case : {true, false})
+        {
+            const std::string plain = scalar_hex(data.data(), size, upper_case, false);
+            const std::string padded = scalar_hex(data.data(), size, upper_case, true);
+
+            std::string encoded(mem::hex_encoded_size(size, false), '\0');
+            CHECK(mem::hex_encode(data.data(), size, &encoded[0], upper_case) == encoded.size());
+            CHECK(encoded == plain);
+
+            CHECK(mem::as_hex({data.data(), size}, upper_case, true) == padded);
+
+            std::ostringstream stream;
+            mem::hex_encode(stream, {data.data(), size}, upper_case, true);
+            CHECK(stream.str() == padded);
+
+            for (const std::string& text : {plain, padded})
+            {
+                std::vector<mem::byte> decoded(size);
+                CHECK(mem::hex_decode(text.data(), text.size(), decoded.data()) == size);
+                CHECK(std::equal(decoded.begin(), decoded.end(), data.begin()));
+            }
+        }
+    }
+
+    // Larger than one stream chunk
+    std::vector<mem::byte> large(0x2345, 0xAB);
+    std::ostringstream stream;
+    mem::hex_encode(stream, {large.data(), large.size()}, true, true);
+    CHECK(stream.str() == mem::as_hex({large.data(), large.size()}));
+
+    mem::byte out[64];
+    CHECK(mem::hex_decode("01 23\n45\t67", 11, out) == 4);
+    CHECK(out[3] == 0x67);
+
+    std::string invalid(64, '0');
+    invalid[40] = 'g';
+    CHECK(mem::hex_decode(invalid.data(), invalid.size(), out) == SIZE_MAX);
+    CHECK(mem::hex_decode("123", 3, out) == SIZE_MAX);
+    CHECK(mem::hex_decode("1 2", 3, out) == SIZE_MAX);
+}
+
+TEST_CASE("mem::hexdump")
+{
+    const char text[] = "Hello, hexdump!\n\x00\x01\xFF" "ABC";
+    const mem::region range(text, sizeof(text) - 1);
+
+    mem::hexdump_options options;
+    options.offsets = true;
+
+    std::ostringstream stream;
+    mem::hexdump(stream, range, options);
+
+    CHECK(stream.str() ==
+        "00000000  48 65 6C 6C 6F 2C 20 68  65 78 64 75 6D 70 21 0A  |Hello, hexdump!.|\n"
+        "00000010  00 01 FF 41 42 43                                 |...ABC|\n");
+
+    options.width = 4;
+    options.ascii = false;
+    options.upper_case = false;
+
+    stream.str("");
+    mem::hexdump(stream, mem::region(text + 16, 6), options);
+    CHECK(stream.str() == "00000000  00 01 ff 41\n00000004  42 43\n");
+
+    // Reading through an accessor matches reading directly, across several chunks
+    std::vector<mem::byte> large(0x12345);
+    std::iota(large.begin(), large.end(), mem::byte(0));
+
+    std::ostringstream direct;
+    std::ostringstream accessed;
+
+    mem::hexdump(direct, {large.data(), large.size()});
+    mem::hexdump(accessed, mem::get_default_accessor(), {large.data(), large.size()});
+
+    const std::string lines = direct.str();
+
+    CHECK(accessed.str() == lines);
+    CHECK(static_cast<size_t>(std::count(lines.begin(), lines.end(), '\n')) == (large.size() + 15) / 16);
 }
 
 void check_unescape_string(const char* string, const void* data, size_t length, bool strict)